@@ -0,0 +1,107 @@
+/*
+ * gesture.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include "APP/GESTURE/gesture.h"
+#include "GPTM.h"
+
+/* States of a button, the ones marked (t) have a pending deadline:
+ * IDLE     --> released, nothing pending
+ * PRESSED  --> first press (t: long press)
+ * RELEASED --> short press released (t: double press gap)
+ * REPRESSED--> second press (t: ramp delay)
+ * RAMPING  --> second press still held (t: ramp period)
+ * HELD     --> long press reported, waiting for the release */
+#define GESTURE_IDLE            0
+#define GESTURE_PRESSED         1
+#define GESTURE_RELEASED        2
+#define GESTURE_REPRESSED       3
+#define GESTURE_RAMPING         4
+#define GESTURE_HELD            5
+
+static void GESTURE_arm(GESTURE_StateType *psState, uint8 ui8State, uint32 ui32From, uint16 ui16Ms)
+{
+    psState->ui8State = ui8State;
+    psState->ui32Deadline = ui32From + ((uint32)ui16Ms * GPTM_TIMESTAMP_TICKS_PER_MS);
+}
+
+void GESTURE_reset(GESTURE_StateType *psState)
+{
+    psState->ui8State = GESTURE_IDLE;
+}
+
+/* Debounced press or release of the button, returns the gesture it completes */
+uint8 GESTURE_event(const GESTURE_ConfigType *psConfig, GESTURE_StateType *psState,
+                    boolean bPressed, uint32 ui32Timestamp)
+{
+    uint8 ui8Gesture = GESTURE_NONE;
+
+    if(bPressed){
+        switch (psState->ui8State) {
+        case GESTURE_IDLE:
+            GESTURE_arm(psState, GESTURE_PRESSED, ui32Timestamp, psConfig->ui16LongPressMs);
+            break;
+        case GESTURE_RELEASED:
+            GESTURE_arm(psState, GESTURE_REPRESSED, ui32Timestamp, psConfig->ui16RampDelayMs);
+            break;
+        default:
+            /* Already pressed: a lost release, keep going */
+            break;
+        }
+    }
+    else{
+        switch (psState->ui8State) {
+        case GESTURE_PRESSED:
+            GESTURE_arm(psState, GESTURE_RELEASED, ui32Timestamp, psConfig->ui16DoubleGapMs);
+            break;
+        case GESTURE_REPRESSED:
+            psState->ui8State = GESTURE_IDLE;
+            ui8Gesture = GESTURE_DOUBLE;
+            break;
+        case GESTURE_RAMPING:
+        case GESTURE_HELD:
+            psState->ui8State = GESTURE_IDLE;
+            break;
+        default:
+            break;
+        }
+    }
+    return ui8Gesture;
+}
+
+/* Close the state whose deadline has passed, returns the gesture it completes */
+uint8 GESTURE_timeout(const GESTURE_ConfigType *psConfig, GESTURE_StateType *psState, uint32 ui32Now)
+{
+    if((GESTURE_getTimeoutMs(psState, ui32Now) == GESTURE_NO_TIMEOUT) ||
+       ((sint32)(ui32Now - psState->ui32Deadline) < 0)){
+        return GESTURE_NONE;
+    }
+
+    switch (psState->ui8State) {
+    case GESTURE_PRESSED:
+        psState->ui8State = GESTURE_HELD;
+        return GESTURE_LONG;
+    case GESTURE_RELEASED:
+        psState->ui8State = GESTURE_IDLE;
+        return GESTURE_CLICK;
+    default:
+        /* GESTURE_REPRESSED or GESTURE_RAMPING, the ramp keeps its own cadence */
+        GESTURE_arm(psState, GESTURE_RAMPING, psState->ui32Deadline, psConfig->ui16RampPeriodMs);
+        return GESTURE_RAMP;
+    }
+}
+
+/* Time until the pending deadline, rounded up to a whole non-zero ms */
+uint32 GESTURE_getTimeoutMs(const GESTURE_StateType *psState, uint32 ui32Now)
+{
+    sint32 i32Left;
+
+    if((psState->ui8State == GESTURE_IDLE) || (psState->ui8State == GESTURE_HELD)){
+        return GESTURE_NO_TIMEOUT;
+    }
+    i32Left = (sint32)(psState->ui32Deadline - ui32Now);
+    return (i32Left <= 0) ? 1U : (((uint32)i32Left + GPTM_TIMESTAMP_TICKS_PER_MS - 1U) / GPTM_TIMESTAMP_TICKS_PER_MS);
+}
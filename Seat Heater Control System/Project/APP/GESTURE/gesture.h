@@ -0,0 +1,48 @@
+/*
+ * gesture.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef APP_GESTURE_GESTURE_H_
+#define APP_GESTURE_GESTURE_H_
+
+#include "std_types.h"
+
+/* Gestures recognized on the debounced presses and releases of one button:
+ * GESTURE_CLICK  --> short press not followed by a second one within the double press gap
+ * GESTURE_DOUBLE --> two short presses, reported on the second release
+ * GESTURE_LONG   --> single press held for the long press time, reported while still held
+ * GESTURE_RAMP   --> short press followed by a press held for the ramp delay, then reported
+ *                    again every ramp period until the button is released */
+#define GESTURE_NONE            0
+#define GESTURE_CLICK           1
+#define GESTURE_DOUBLE          2
+#define GESTURE_LONG            3
+#define GESTURE_RAMP            4
+
+/* Returned by GESTURE_getTimeoutMs() when the button waits for its next edge only */
+#define GESTURE_NO_TIMEOUT      (0xFFFFFFFFU)
+
+/* Thresholds in ms, shared by every button */
+typedef struct {
+    uint16 ui16LongPressMs;     /* held this long after a single press --> GESTURE_LONG */
+    uint16 ui16DoubleGapMs;     /* longest release between the two presses of GESTURE_DOUBLE */
+    uint16 ui16RampDelayMs;     /* second press held this long --> first GESTURE_RAMP */
+    uint16 ui16RampPeriodMs;    /* GESTURE_RAMP repeat period while still held */
+}GESTURE_ConfigType;
+
+/* State machine of one button, the deadline is only meaningful while a timeout is pending */
+typedef struct {
+    uint8 ui8State;
+    uint32 ui32Deadline;        /* GPTM_WTimer1Read() ticks */
+}GESTURE_StateType;
+
+void GESTURE_reset(GESTURE_StateType *psState);
+uint8 GESTURE_event(const GESTURE_ConfigType *psConfig, GESTURE_StateType *psState,
+                    boolean bPressed, uint32 ui32Timestamp);
+uint8 GESTURE_timeout(const GESTURE_ConfigType *psConfig, GESTURE_StateType *psState, uint32 ui32Now);
+uint32 GESTURE_getTimeoutMs(const GESTURE_StateType *psState, uint32 ui32Now);
+
+#endif /* APP_GESTURE_GESTURE_H_ */
@@ -0,0 +1,212 @@
+/*
+ * log.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include "APP/LOG/log.h"
+#include "APP/TELEMETRY/telemetry.h"
+#include "crc16.h"
+#include "fmt.h"
+#include "GPTM.h"
+
+#define LOG_RING_MASK               (LOG_RING_WORDS - 1)
+
+/* Orders the words of a record against its header, as SAMPLE_RING_BARRIER() */
+#if defined(__TI_ARM__) || defined(__arm__)
+#define LOG_BARRIER()               __asm("    dmb")
+#else
+#define LOG_BARRIER()               __sync_synchronize()
+#endif
+
+/* Free running word indexes: the writers reserve by moving the head, the drain hands the
+ * words back by moving the tail */
+static volatile uint32 ui32LogHead = 0;
+static volatile uint32 ui32LogTail = 0;
+static volatile uint32 ui32LogDropped = 0;
+static volatile uint32 pui32LogRing[LOG_RING_WORDS];
+
+static uint16 ui16LogSequence = 0;
+
+/* Compare and swap of a word shared by tasks and interrupts. An exception between the
+ * LDREX and the STREX clears the exclusive monitor: the STREX fails and the caller retries
+ * with the value left by the interrupting writer */
+static boolean LOG_compareAndSwap(volatile uint32 *pui32Word, uint32 ui32Expected, uint32 ui32Desired)
+{
+#if defined(__TI_ARM__)
+    if((uint32)__ldrex((void *)pui32Word) != ui32Expected){
+        return FALSE;
+    }
+    return (__strex(ui32Desired, (void *)pui32Word) == 0) ? TRUE : FALSE;
+#else
+    return __atomic_compare_exchange_n(pui32Word, &ui32Expected, ui32Desired, 0, __ATOMIC_SEQ_CST,
+                                       __ATOMIC_SEQ_CST) ? TRUE : FALSE;
+#endif
+}
+
+/* Store a record, from any task or interrupt, use the LOG0() .. LOG4() macros. When the
+ * ring is full the record is dropped and counted */
+void LOG_record(uint32 ui32Header, const uint32 *pui32Args)
+{
+    uint32 ui32Args = (ui32Header & LOG_HEADER_ARGS_MASK) >> LOG_HEADER_ARGS_SHIFT;
+    uint32 ui32Words = LOG_RECORD_WORDS(ui32Args);
+    uint32 ui32Timestamp = GPTM_WTimer1Read();
+    uint32 ui32Head;
+    uint32 ui32Dropped;
+    uint32 ui32Arg;
+
+    do{
+        ui32Head = ui32LogHead;
+        if((ui32Head + ui32Words - ui32LogTail) > LOG_RING_WORDS){
+            do{
+                ui32Dropped = ui32LogDropped;
+            }while(LOG_compareAndSwap(&ui32LogDropped, ui32Dropped, ui32Dropped + 1) == FALSE);
+            return;
+        }
+    }while(LOG_compareAndSwap(&ui32LogHead, ui32Head, ui32Head + ui32Words) == FALSE);
+
+    /* The words are ours, writers interrupting us reserve after them */
+    pui32LogRing[(ui32Head + 1) & LOG_RING_MASK] = ui32Timestamp;
+    for(ui32Arg = 0; ui32Arg < ui32Args; ui32Arg++){
+        pui32LogRing[(ui32Head + 2 + ui32Arg) & LOG_RING_MASK] = pui32Args[ui32Arg];
+    }
+    LOG_BARRIER();
+    pui32LogRing[ui32Head & LOG_RING_MASK] = ui32Header | LOG_HEADER_COMMITTED;
+}
+
+/* Records dropped because the ring was full, since start up */
+uint32 LOG_getDropped(void)
+{
+    return ui32LogDropped;
+}
+
+/* Header of the oldest record, FALSE when the ring is empty or when that record is still
+ * being written by a caller the drain interrupted */
+static boolean LOG_peek(uint32 *pui32Header)
+{
+    uint32 ui32Tail = ui32LogTail;
+
+    if(ui32Tail == ui32LogHead){
+        return FALSE;
+    }
+    *pui32Header = pui32LogRing[ui32Tail & LOG_RING_MASK];
+    if((*pui32Header & LOG_HEADER_COMMITTED) == 0){
+        return FALSE;
+    }
+    LOG_BARRIER();      /* Read the words only after the header that published them */
+    return TRUE;
+}
+
+/* Hand the words of the oldest record back to the writers. They are cleared: a stale word
+ * with the committed flag would be taken for the header of a record not written yet */
+static void LOG_release(uint32 ui32Words)
+{
+    uint32 ui32Tail = ui32LogTail;
+    uint32 ui32Word;
+
+    for(ui32Word = 0; ui32Word < ui32Words; ui32Word++){
+        pui32LogRing[(ui32Tail + ui32Word) & LOG_RING_MASK] = 0;
+    }
+    LOG_BARRIER();
+    ui32LogTail = ui32Tail + ui32Words;
+}
+
+static uint8 *LOG_put32(uint8 *pui8Out, uint32 ui32Value)
+{
+    pui8Out[0] = (uint8)ui32Value;
+    pui8Out[1] = (uint8)(ui32Value >> 8);
+    pui8Out[2] = (uint8)(ui32Value >> 16);
+    pui8Out[3] = (uint8)(ui32Value >> 24);
+    return pui8Out + 4;
+}
+
+/* Move the oldest records into a delimited binary frame (layout in log.h), pui8Frame must
+ * hold LOG_MAX_FRAME_SIZE bytes. Returns the frame length, 0 when there is no record */
+uint32 LOG_buildFrame(uint8 *pui8Frame)
+{
+    uint8 pui8Record[LOG_FRAME_HEADER_SIZE + LOG_FRAME_RECORDS_SIZE + LOG_FRAME_CRC_SIZE];
+    uint8 *pui8Records = &pui8Record[LOG_FRAME_HEADER_SIZE];
+    uint8 *pui8Out = pui8Records;
+    uint32 ui32Header;
+    uint32 ui32Words;
+    uint32 ui32Word;
+    uint32 ui32Length;
+    uint16 ui16Crc;
+
+    while(LOG_peek(&ui32Header)){
+        ui32Words = LOG_RECORD_WORDS((ui32Header & LOG_HEADER_ARGS_MASK) >> LOG_HEADER_ARGS_SHIFT);
+        if((uint32)(pui8Out - pui8Records) + (4 * ui32Words) > LOG_FRAME_RECORDS_SIZE){
+            break;
+        }
+        pui8Out = LOG_put32(pui8Out, ui32Header & ~LOG_HEADER_COMMITTED);
+        for(ui32Word = 1; ui32Word < ui32Words; ui32Word++){
+            pui8Out = LOG_put32(pui8Out, pui32LogRing[(ui32LogTail + ui32Word) & LOG_RING_MASK]);
+        }
+        LOG_release(ui32Words);
+    }
+    if(pui8Out == pui8Records){
+        return 0;
+    }
+
+    pui8Record[0] = TELEMETRY_VERSION;
+    pui8Record[1] = TELEMETRY_RECORD_LOG;
+    pui8Record[2] = (uint8)ui16LogSequence;
+    pui8Record[3] = (uint8)(ui16LogSequence >> 8);
+    ui16LogSequence++;
+    LOG_put32(&pui8Record[4], ui32LogDropped);
+    ui32Length = (uint32)(pui8Out - pui8Record);
+    ui16Crc = CRC16_update(CRC16_INIT, pui8Record, ui32Length);
+    pui8Record[ui32Length++] = (uint8)ui16Crc;
+    pui8Record[ui32Length++] = (uint8)(ui16Crc >> 8);
+
+    pui8Frame[0] = COBS_DELIMITER;
+    ui32Length = COBS_encode(pui8Record, ui32Length, &pui8Frame[1]) + 1;
+    pui8Frame[ui32Length++] = COBS_DELIMITER;
+    return ui32Length;
+}
+
+/* Move the oldest record into pui8Text as "[seconds.usec] text\r\n", formatted on the
+ * target for a terminal. pui8Text must hold LOG_MAX_TEXT_SIZE bytes. Returns the length,
+ * 0 when there is no record */
+uint32 LOG_popText(uint8 *pui8Text)
+{
+    uint32 pui32Args[LOG_MAX_ARGS];
+    uint32 ui32Header;
+    uint32 ui32Args;
+    uint32 ui32Timestamp;
+    uint32 ui32Arg;
+    uint32 ui32Length = 0;
+    const char *pcFormat;
+
+    if(LOG_peek(&ui32Header) == FALSE){
+        return 0;
+    }
+    ui32Args = (ui32Header & LOG_HEADER_ARGS_MASK) >> LOG_HEADER_ARGS_SHIFT;
+    ui32Timestamp = pui32LogRing[(ui32LogTail + 1) & LOG_RING_MASK];
+    for(ui32Arg = 0; (ui32Arg < ui32Args) && (ui32Arg < LOG_MAX_ARGS); ui32Arg++){
+        pui32Args[ui32Arg] = pui32LogRing[(ui32LogTail + 2 + ui32Arg) & LOG_RING_MASK];
+    }
+    LOG_release(LOG_RECORD_WORDS(ui32Args));
+
+    pui8Text[ui32Length++] = '[';
+    ui32Length += FMT_u32(&pui8Text[ui32Length], ui32Timestamp / 1000000);
+    pui8Text[ui32Length++] = '.';
+    ui32Length += FMT_u32Pad(&pui8Text[ui32Length], ui32Timestamp % 1000000, 6, '0');
+    pui8Text[ui32Length++] = ']';
+    pui8Text[ui32Length++] = ' ';
+
+    /* Room is kept for the line end */
+    pcFormat = LOG_getFormat(ui32Header & LOG_HEADER_ID_MASK);
+    if(pcFormat == NULL_PTR){
+        pui32Args[0] = ui32Header & LOG_HEADER_ID_MASK;
+        ui32Length += LOG_format("unknown log message %u", pui32Args, 1, &pui8Text[ui32Length],
+                                 LOG_MAX_TEXT_SIZE - 2 - ui32Length);
+    }else{
+        ui32Length += LOG_format(pcFormat, pui32Args, ui32Arg, &pui8Text[ui32Length],
+                                 LOG_MAX_TEXT_SIZE - 2 - ui32Length);
+    }
+    pui8Text[ui32Length++] = '\r';
+    pui8Text[ui32Length++] = '\n';
+    return ui32Length;
+}
@@ -0,0 +1,87 @@
+/*
+ * log.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef APP_LOG_LOG_H_
+#define APP_LOG_LOG_H_
+
+#include "std_types.h"
+#include "cobs.h"
+
+/* Deferred log: a call site only stores the ID of its message (APP/LOG/log_messages.h), a
+ * timestamp and its raw 32-bit arguments into a RAM ring, nothing is formatted and no lock
+ * is taken. The low priority drain sends the records later, LOG_buildFrame() as binary
+ * frames turned back into text by Tools/log_decode, or LOG_popText() formatted on the
+ * target for a terminal.
+ *
+ * The calls are safe from any task and from any interrupt, whatever its priority: the
+ * space of a record is reserved by LDREX/STREX on the ring head, an exception between the
+ * two clears the exclusive monitor and the reservation is retried. The record is written
+ * in its reserved words and published last by its header. A record that does not fit is
+ * dropped and counted, the caller never waits */
+
+typedef enum {
+#define LOG_MESSAGE(id, format)     id,
+#include "APP/LOG/log_messages.h"
+#undef LOG_MESSAGE
+    LOG_MSG_COUNT
+} LOG_MessageType;
+
+#define LOG_MAX_ARGS                4
+
+/* Ring of 32-bit words, must be a power of 2. A record takes LOG_RECORD_WORDS(args) */
+#define LOG_RING_WORDS              256
+#define LOG_RECORD_WORDS(args)      (2U + (args))
+
+/* Record header: message ID, argument count and the committed flag set by the writer last */
+#define LOG_HEADER_ID_MASK          0x0000FFFFUL
+#define LOG_HEADER_ARGS_SHIFT       16
+#define LOG_HEADER_ARGS_MASK        0x00070000UL
+#define LOG_HEADER_COMMITTED        0x80000000UL
+#define LOG_HEADER(id, args)        ((uint32)(id) | ((uint32)(args) << LOG_HEADER_ARGS_SHIFT))
+
+/* Binary frame of LOG_buildFrame(), little endian, record type TELEMETRY_RECORD_LOG of
+ * the telemetry stream (APP/TELEMETRY/telemetry.h):
+ *  offset  size  field
+ *       0     1  TELEMETRY_VERSION
+ *       1     1  TELEMETRY_RECORD_LOG
+ *       2     2  log frame sequence number, wraps
+ *       4     4  records dropped since start up
+ *       8        records, each: header (4) without the committed flag, timestamp in
+ *                GPTM_WTimer1Read() usec (4), arguments (4 each)
+ *       .     2  CRC-16/CCITT-FALSE of all the bytes above
+ * COBS encoded between two delimiters like the status records */
+#define LOG_FRAME_HEADER_SIZE       8
+#define LOG_FRAME_RECORDS_SIZE      120
+#define LOG_FRAME_CRC_SIZE          2
+#define LOG_MAX_FRAME_SIZE          (COBS_MAX_ENCODED_SIZE(LOG_FRAME_HEADER_SIZE + LOG_FRAME_RECORDS_SIZE + LOG_FRAME_CRC_SIZE) + 2)
+
+/* Longest line of LOG_popText(): "[seconds.usec] " and the message */
+#define LOG_MAX_TEXT_SIZE           128
+
+#define LOG0(id)                    LOG_record(LOG_HEADER(id, 0), NULL_PTR)
+#define LOG1(id, a)                 do { const uint32 pui32LogArgs[1] = { (uint32)(a) }; \
+                                         LOG_record(LOG_HEADER(id, 1), pui32LogArgs); } while(0)
+#define LOG2(id, a, b)              do { const uint32 pui32LogArgs[2] = { (uint32)(a), (uint32)(b) }; \
+                                         LOG_record(LOG_HEADER(id, 2), pui32LogArgs); } while(0)
+#define LOG3(id, a, b, c)           do { const uint32 pui32LogArgs[3] = { (uint32)(a), (uint32)(b), (uint32)(c) }; \
+                                         LOG_record(LOG_HEADER(id, 3), pui32LogArgs); } while(0)
+#define LOG4(id, a, b, c, d)        do { const uint32 pui32LogArgs[4] = { (uint32)(a), (uint32)(b), (uint32)(c), \
+                                                                          (uint32)(d) }; \
+                                         LOG_record(LOG_HEADER(id, 4), pui32LogArgs); } while(0)
+
+void LOG_record(uint32 ui32Header, const uint32 *pui32Args);
+uint32 LOG_getDropped(void);
+
+/* Drain side, a single task */
+uint32 LOG_buildFrame(uint8 *pui8Frame);
+uint32 LOG_popText(uint8 *pui8Text);
+
+/* Text of a message, shared with the host decoder */
+const char *LOG_getFormat(uint32 ui32Id);
+uint32 LOG_format(const char *pcFormat, const uint32 *pui32Args, uint32 ui32Args, uint8 *pui8Out, uint32 ui32Size);
+
+#endif /* APP_LOG_LOG_H_ */
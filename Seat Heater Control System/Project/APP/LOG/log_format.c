@@ -0,0 +1,108 @@
+/*
+ * log_format.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include <stdint.h>
+#include "APP/LOG/log.h"
+#include "fmt.h"
+
+/* Argument word read as signed: int32_t is 32 bits also where sint32 is wider, as in the
+ * host decoder */
+#define LOG_SIGNED(value)           ((sint32)(int32_t)(uint32_t)(value))
+
+/* Only referenced by LOG_popText() and by the host decoder: a firmware sending binary
+ * frames does not need the strings */
+static const char *const ppcLogFormats[LOG_MSG_COUNT] = {
+#define LOG_MESSAGE(id, format)     format,
+#include "APP/LOG/log_messages.h"
+#undef LOG_MESSAGE
+};
+
+const char *LOG_getFormat(uint32 ui32Id)
+{
+    return (ui32Id < LOG_MSG_COUNT) ? ppcLogFormats[ui32Id] : NULL_PTR;
+}
+
+/* Decimal number of a %q conversion, stops at the first other character */
+static uint8 LOG_parseNumber(const char **ppcFormat, uint8 ui8Max)
+{
+    uint32 ui32Value = 0;
+
+    while((**ppcFormat >= '0') && (**ppcFormat <= '9')){
+        ui32Value = (ui32Value * 10) + (uint32)(*(*ppcFormat)++ - '0');
+        if(ui32Value > ui8Max){
+            ui32Value = ui8Max;
+        }
+    }
+    return (uint8)ui32Value;
+}
+
+/* Text of a message with its arguments (conversions in log_messages.h) into ui32Size bytes
+ * of pui8Out, cut when it does not fit. An argument missing from the record prints '?'.
+ * Returns the length, without terminating '\0' */
+uint32 LOG_format(const char *pcFormat, const uint32 *pui32Args, uint32 ui32Args, uint8 *pui8Out, uint32 ui32Size)
+{
+    uint8 pui8Field[FMT_Q32_MAX_SIZE];
+    uint32 ui32Length = 0;
+    uint32 ui32Arg = 0;
+
+    while(*pcFormat != '\0'){
+        uint32 ui32FieldLength = 1;
+        uint32 ui32Index;
+
+        pui8Field[0] = (uint8)*pcFormat++;
+        if((pui8Field[0] == '%') && (*pcFormat != '\0')){
+            char cConversion = *pcFormat++;
+            boolean bMissing = FALSE;
+            uint32 ui32Value = 0;
+            uint8 ui8FracBits;
+            uint8 ui8Decimals = 0;
+
+            if(cConversion != '%'){
+                if(ui32Arg < ui32Args){
+                    ui32Value = pui32Args[ui32Arg];
+                }else{
+                    bMissing = TRUE;
+                }
+                ui32Arg++;
+            }
+
+            switch(cConversion){
+            case '%':
+                break;
+            case 'u':
+                ui32FieldLength = FMT_u32(pui8Field, ui32Value);
+                break;
+            case 'd':
+                ui32FieldLength = FMT_s32(pui8Field, LOG_SIGNED(ui32Value));
+                break;
+            case 'x':
+                ui32FieldLength = FMT_x32(pui8Field, ui32Value);
+                break;
+            case 'q':
+                ui8FracBits = LOG_parseNumber(&pcFormat, FMT_Q_MAX_FRAC_BITS);
+                if(*pcFormat == '.'){
+                    pcFormat++;
+                    ui8Decimals = LOG_parseNumber(&pcFormat, FMT_Q_MAX_DECIMALS);
+                }
+                ui32FieldLength = FMT_q32(pui8Field, LOG_SIGNED(ui32Value), ui8FracBits, ui8Decimals);
+                break;
+            default:
+                bMissing = TRUE;
+                break;
+            }
+            if(bMissing){
+                pui8Field[0] = '?';
+                ui32FieldLength = 1;
+            }
+        }
+
+        for(ui32Index = 0; (ui32Index < ui32FieldLength) && (ui32Length < ui32Size); ui32Index++){
+            pui8Out[ui32Length++] = pui8Field[ui32Index];
+        }
+    }
+    return ui32Length;
+}
@@ -0,0 +1,28 @@
+/*
+ * log_messages.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+/* Format strings of the deferred log (APP/LOG/log.h), one LOG_MESSAGE(id, format) per
+ * message. No include guard: the file is expanded once into the LOG_MessageType IDs and
+ * once into the string table read by LOG_format(), on the target and by Tools/log_decode.
+ * A record only carries the index of its message, so append new messages at the end and
+ * never reorder them while logs of an older firmware may still be decoded.
+ *
+ * Conversions, one 32-bit argument each, at most LOG_MAX_ARGS per message:
+ * %u unsigned, %d signed, %x hexadecimal, %q<bits>.<decimals> signed Q-format fixed
+ * point (%q8.1 for a Q8 temperature), %% for a percent sign */
+
+LOG_MESSAGE(LOG_MSG_CPU_LOAD_TASK_TIME,     "CPU Load Measurement Task execution time is %u msec")
+LOG_MESSAGE(LOG_MSG_DISPLAY_TASK_TIME,      "Display System State Task execution time is %u msec")
+LOG_MESSAGE(LOG_MSG_CONTROL_TASK_TIME,      "Seats Control Task execution time is %u msec")
+LOG_MESSAGE(LOG_MSG_INPUT_TASK_TIME,        "Seats Input Task execution time is %u msec")
+LOG_MESSAGE(LOG_MSG_CPU_LOAD,               "CPU Load is %u%%")
+LOG_MESSAGE(LOG_MSG_UART_TX_DROPPED,        "UART0 dropped %u bytes since start up")
+LOG_MESSAGE(LOG_MSG_UART_BENCH_SIZE,        "UART0 transmit of %u bytes")
+LOG_MESSAGE(LOG_MSG_UART_BENCH_POLLED,      "polled: %u bytes/s, CPU %d%%")
+LOG_MESSAGE(LOG_MSG_UART_BENCH_INTERRUPT,   "interrupt: %u bytes/s, CPU %d%%")
+LOG_MESSAGE(LOG_MSG_UART_BENCH_DMA,         "uDMA: %u bytes/s, CPU %d%%")
+LOG_MESSAGE(LOG_MSG_LOG_DROPPED,            "%u log records dropped since start up")
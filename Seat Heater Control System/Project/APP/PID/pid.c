@@ -0,0 +1,64 @@
+/*
+ * pid.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include "APP/PID/pid.h"
+
+static sint32 PID_clamp(sint32 i32Value, sint32 i32Min, sint32 i32Max)
+{
+    if(i32Value < i32Min){
+        return i32Min;
+    }
+    if(i32Value > i32Max){
+        return i32Max;
+    }
+    return i32Value;
+}
+
+/* Empty the integrator and take the current measurement as derivative reference,
+ * called whenever the controller is (re)engaged */
+void PID_reset(PID_StateType *psState, sint16 i16MeasurementQ8)
+{
+    psState->i32Integrator = 0;
+    psState->i16LastMeasurementQ8 = i16MeasurementQ8;
+}
+
+/* One control period, returns the Q15 duty cycle */
+uint16 PID_update(const PID_ConfigType *psConfig, PID_StateType *psState,
+                  sint16 i16SetpointQ8, sint16 i16MeasurementQ8)
+{
+    sint32 i32Error = (sint32)i16SetpointQ8 - i16MeasurementQ8;
+    sint32 i32Delta = (sint32)i16MeasurementQ8 - psState->i16LastMeasurementQ8;
+    sint32 i32Integrator;
+    sint32 i32Output;
+    sint32 i32Duty;
+
+    /* 32x32 --> 64 products, a single SMULL on the Cortex-M4 */
+    i32Integrator = psState->i32Integrator +
+                    (sint32)(((sint64)psConfig->i32Ki * i32Error) >> (PID_PRODUCT_SHIFT - PID_INTEGRATOR_EXTRA_BITS));
+    i32Integrator = PID_clamp(i32Integrator,
+                              psConfig->i32IntegratorMin * (1L << PID_INTEGRATOR_EXTRA_BITS),
+                              psConfig->i32IntegratorMax * (1L << PID_INTEGRATOR_EXTRA_BITS));
+
+    i32Output = (sint32)(((sint64)psConfig->i32Kp * i32Error) >> PID_PRODUCT_SHIFT)
+              + (i32Integrator >> PID_INTEGRATOR_EXTRA_BITS)
+              - (sint32)(((sint64)psConfig->i32Kd * i32Delta) >> PID_PRODUCT_SHIFT);
+
+    i32Duty = PID_clamp(i32Output, 0, PID_DUTY_MAX);
+
+    /* Back-calculation anti-windup: bleed the part of the output the heater could not deliver */
+    if(i32Duty != i32Output){
+        i32Integrator += (sint32)(((sint64)psConfig->i32Kb * (i32Duty - i32Output)) >> (PID_GAIN_FRAC_BITS - PID_INTEGRATOR_EXTRA_BITS));
+        i32Integrator = PID_clamp(i32Integrator,
+                                  psConfig->i32IntegratorMin * (1L << PID_INTEGRATOR_EXTRA_BITS),
+                                  psConfig->i32IntegratorMax * (1L << PID_INTEGRATOR_EXTRA_BITS));
+    }
+
+    psState->i32Integrator = i32Integrator;
+    psState->i16LastMeasurementQ8 = i16MeasurementQ8;
+
+    return (uint16)i32Duty;
+}
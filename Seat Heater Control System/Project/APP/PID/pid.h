@@ -0,0 +1,56 @@
+/*
+ * pid.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef APP_PID_PID_H_
+#define APP_PID_PID_H_
+
+#include "std_types.h"
+
+/* Output duty cycle in Q15: 0 --> heater off, PID_DUTY_MAX --> heater fully on */
+#define PID_DUTY_FRAC_BITS      15
+#define PID_DUTY_MAX            ((1L << PID_DUTY_FRAC_BITS) - 1)
+
+/* Gains are Q16 (PID_GAIN(1.0) == 65536), errors and temperatures are Q8 °C */
+#define PID_GAIN_FRAC_BITS      16
+#define PID_TEMP_FRAC_BITS      8
+#define PID_GAIN(x)             ((sint32)((x) * (1L << PID_GAIN_FRAC_BITS) + 0.5))
+
+/* The integrator keeps PID_INTEGRATOR_EXTRA_BITS more fraction bits than the duty so
+ * that small errors still accumulate with small Ki */
+#define PID_INTEGRATOR_EXTRA_BITS   8
+
+/* Product of a Q16 gain and a Q8 temperature back to a Q15 duty */
+#define PID_PRODUCT_SHIFT       (PID_GAIN_FRAC_BITS + PID_TEMP_FRAC_BITS - PID_DUTY_FRAC_BITS)
+
+/* Discrete controller running once per control period, gains are given per period:
+ * i32Kp --> duty per °C of error
+ * i32Ki --> duty per °C of error accumulated every period
+ * i32Kd --> duty per °C of temperature change over one period (derivative on measurement,
+ *           a setpoint step does not kick the output)
+ * i32Kb --> back-calculation gain, fraction of the saturation excess removed from the
+ *           integrator every period
+ * The integrator is also clamped to [i32IntegratorMin, i32IntegratorMax] (Q15 duty).
+ * |gain| must stay below PID_GAIN(8.0) */
+typedef struct {
+    sint32 i32Kp;
+    sint32 i32Ki;
+    sint32 i32Kd;
+    sint32 i32Kb;
+    sint32 i32IntegratorMin;
+    sint32 i32IntegratorMax;
+}PID_ConfigType;
+
+typedef struct {
+    sint32 i32Integrator;       /* Q15 duty << PID_INTEGRATOR_EXTRA_BITS */
+    sint16 i16LastMeasurementQ8;
+}PID_StateType;
+
+void PID_reset(PID_StateType *psState, sint16 i16MeasurementQ8);
+uint16 PID_update(const PID_ConfigType *psConfig, PID_StateType *psState,
+                  sint16 i16SetpointQ8, sint16 i16MeasurementQ8);
+
+#endif /* APP_PID_PID_H_ */
@@ -0,0 +1,89 @@
+/*
+ * power.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include "APP/POWER/power.h"
+
+/* Totals of the last arbitration, kept for telemetry */
+static volatile uint32 ui32PowerRequestedMa;
+static volatile uint32 ui32PowerGrantedMa;
+
+/* Average current drawn by a consumer at the given duty */
+static uint32 POWER_currentMa(uint16 ui16DutyQ15, uint16 ui16CurrentMa)
+{
+    return ((uint32)ui16DutyQ15 * ui16CurrentMa) >> POWER_DUTY_FRAC_BITS;
+}
+
+/* Share the budget between the requests in O(consumers), at most one division per call.
+ * The granted pulses are also laid end to end in pui8Order: as long as the granted duties
+ * add up to less than a full period, the heaters take turns on the supply and are never on
+ * together, beyond that no more than ceil(sum of duties) of them overlap */
+void POWER_arbitrate(const POWER_ConfigType *psConfig, const uint16 *pui16RequestedQ15,
+                     uint16 *pui16GrantedQ15, uint16 *pui16PhaseQ15)
+{
+    uint8 ui8Index;
+    uint32 ui32RequestedMa = 0;
+    uint32 ui32GrantedMa = 0;
+    uint32 ui32PhaseQ15 = 0;
+
+    for(ui8Index = 0; ui8Index < psConfig->ui8Count; ui8Index++){
+        ui32RequestedMa += POWER_currentMa(pui16RequestedQ15[ui8Index], psConfig->pui16CurrentMa[ui8Index]);
+    }
+
+    if(ui32RequestedMa <= psConfig->ui16BudgetMa){
+        for(ui8Index = 0; ui8Index < psConfig->ui8Count; ui8Index++){
+            pui16GrantedQ15[ui8Index] = pui16RequestedQ15[ui8Index];
+        }
+    }
+    else if(psConfig->ui8Policy == POWER_POLICY_FAIR){
+        /* ui16BudgetMa < 2^16 so the Q15 scale fits in 32 bits */
+        uint32 ui32ScaleQ15 = ((uint32)psConfig->ui16BudgetMa << POWER_DUTY_FRAC_BITS) / ui32RequestedMa;
+
+        for(ui8Index = 0; ui8Index < psConfig->ui8Count; ui8Index++){
+            pui16GrantedQ15[ui8Index] = (uint16)(((uint32)pui16RequestedQ15[ui8Index] * ui32ScaleQ15) >> POWER_DUTY_FRAC_BITS);
+        }
+    }
+    else{
+        uint32 ui32RemainingMa = psConfig->ui16BudgetMa;
+
+        for(ui8Index = 0; ui8Index < psConfig->ui8Count; ui8Index++){
+            uint8 ui8Consumer = psConfig->pui8Order[ui8Index];
+            uint16 ui16CurrentMa = psConfig->pui16CurrentMa[ui8Consumer];
+            uint32 ui32NeededMa = POWER_currentMa(pui16RequestedQ15[ui8Consumer], ui16CurrentMa);
+
+            if(ui32NeededMa <= ui32RemainingMa){
+                pui16GrantedQ15[ui8Consumer] = pui16RequestedQ15[ui8Consumer];
+                ui32RemainingMa -= ui32NeededMa;
+            }
+            else{
+                /* Only the first consumer that does not fit gets a partial grant */
+                pui16GrantedQ15[ui8Consumer] = (uint16)((ui32RemainingMa << POWER_DUTY_FRAC_BITS) / ui16CurrentMa);
+                ui32RemainingMa = 0;
+            }
+        }
+    }
+
+    for(ui8Index = 0; ui8Index < psConfig->ui8Count; ui8Index++){
+        uint8 ui8Consumer = psConfig->pui8Order[ui8Index];
+
+        pui16PhaseQ15[ui8Consumer] = (uint16)(ui32PhaseQ15 & POWER_DUTY_MAX);
+        ui32PhaseQ15 += pui16GrantedQ15[ui8Consumer];
+        ui32GrantedMa += POWER_currentMa(pui16GrantedQ15[ui8Consumer], psConfig->pui16CurrentMa[ui8Consumer]);
+    }
+
+    ui32PowerRequestedMa = ui32RequestedMa;
+    ui32PowerGrantedMa = ui32GrantedMa;
+}
+
+uint32 POWER_getRequestedMa(void)
+{
+    return ui32PowerRequestedMa;
+}
+
+uint32 POWER_getGrantedMa(void)
+{
+    return ui32PowerGrantedMa;
+}
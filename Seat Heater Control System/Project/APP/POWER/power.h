@@ -0,0 +1,38 @@
+/*
+ * power.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef APP_POWER_POWER_H_
+#define APP_POWER_POWER_H_
+
+#include "std_types.h"
+
+/* Duty cycles and phases are Q15 fractions of the heater PWM period */
+#define POWER_DUTY_FRAC_BITS    15
+#define POWER_DUTY_MAX          ((1U << POWER_DUTY_FRAC_BITS) - 1U)
+
+/* Allocation policies when the requests exceed the budget:
+ * POWER_POLICY_FAIR     --> every consumer is scaled down by the same factor
+ * POWER_POLICY_PRIORITY --> consumers are served in pui8Order until the budget runs out */
+#define POWER_POLICY_FAIR       0
+#define POWER_POLICY_PRIORITY   1
+
+/* Static description of the supply and of its consumers, ui16BudgetMa is the average
+ * current the vehicle allows for all the heaters together */
+typedef struct {
+    uint16 ui16BudgetMa;
+    uint8 ui8Policy;
+    uint8 ui8Count;
+    const uint16 *pui16CurrentMa;   /* current of each consumer when fully on */
+    const uint8 *pui8Order;         /* consumer indices, highest priority first */
+}POWER_ConfigType;
+
+void POWER_arbitrate(const POWER_ConfigType *psConfig, const uint16 *pui16RequestedQ15,
+                     uint16 *pui16GrantedQ15, uint16 *pui16PhaseQ15);
+uint32 POWER_getRequestedMa(void);
+uint32 POWER_getGrantedMa(void);
+
+#endif /* APP_POWER_POWER_H_ */
@@ -0,0 +1,369 @@
+/*
+ * seat.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include "APP/SEAT/seat.h"
+#include "APP/SEAT/seat_fsm.h"
+#include <HAL/POTS/pots.h>
+#include <HAL/POTS/pots_lut.h>
+#include <HAL/HEATER/heater.h>
+#include "GPTM.h"
+
+#if (SEAT_COUNT > POTS_NUM_CHANNELS)
+#error "Every seat needs its own POTS channel"
+#endif
+
+#if (SEAT_COUNT > HEATER_NUM_OUTPUTS)
+#error "Every seat needs its own HEATER output"
+#endif
+
+/* Run-time state of a seat, the static part lives in psSeatConfig[] */
+typedef struct {
+    sint16 i16TempQ8;                   /* newest sensor temperature */
+    uint32 ui32LastSampleTime;          /* timestamp of the newest sample */
+    boolean bPidEngaged;
+    uint8 ui8Leds;                      /* SEAT_LED_* pattern currently shown */
+    uint32 ui32PidDeadline;             /* timestamp of the next PID period */
+    PID_StateType sPid;
+}SEAT_RuntimeType;
+
+static SystemStateStructureType *psSeatSystemState;
+static SEAT_RuntimeType psSeatRuntime[SEAT_COUNT];
+static uint32 ui32SeatEventMask;
+
+/* Gesture recognizer of each level button, indexed by button */
+static GESTURE_StateType psSeatGestures[SEAT_BUTTON_COUNT];
+
+/* Shared drain buffer, the seats are only ever processed from the control engine task */
+static SAMPLE_Type psSeatSamples[SEAT_SAMPLES_BATCH];
+
+/* Power arbitration buffers, indexed by seat */
+static uint16 pui16SeatRequestedDuty[SEAT_COUNT];
+static uint16 pui16SeatGrantedDuty[SEAT_COUNT];
+static uint16 pui16SeatPhase[SEAT_COUNT];
+
+/* Pulse last written to the heater of each seat, an impossible phase forces the first write */
+#define SEAT_PHASE_UNKNOWN  (0xFFFFU)
+static uint16 pui16SeatAppliedDuty[SEAT_COUNT];
+static uint16 pui16SeatAppliedPhase[SEAT_COUNT];
+
+/* Duty cycle reported for each discrete heater state */
+static const uint16 pui16SeatHeaterDuty[] = {
+    0,                  /* HEATER_OFF    */
+    SEAT_DUTY_LOW,      /* HEATER_LOW    */
+    SEAT_DUTY_MEDIUM,   /* HEATER_MEDIUM */
+    SEAT_DUTY_HIGH,     /* HEATER_HIGH   */
+};
+
+/* Indicator LEDs turned on and off for each heater state of a PID seat */
+static const uint8 pui8SeatPidLedsOn[] = {
+    0,                                  /* HEATER_OFF    */
+    SEAT_LED_GREEN | SEAT_LED_BLUE,     /* HEATER_LOW    */
+    SEAT_LED_BLUE,                      /* HEATER_MEDIUM */
+    SEAT_LED_GREEN,                     /* HEATER_HIGH   */
+};
+
+/* Turn the ui8On LEDs on and the ui8Off ones off, only the LEDs that actually change are written */
+static void SEAT_applyLeds(uint8 ui8Seat, uint8 ui8On, uint8 ui8Off)
+{
+    const SEAT_LedDriverType *psLeds = psSeatConfig[ui8Seat].psLeds;
+    SEAT_RuntimeType *psRuntime = &psSeatRuntime[ui8Seat];
+    uint8 ui8Leds = (uint8)((psRuntime->ui8Leds & ~ui8Off) | ui8On);
+    uint8 ui8Changed = ui8Leds ^ psRuntime->ui8Leds;
+
+    if(ui8Changed & SEAT_LED_RED){
+        if(ui8Leds & SEAT_LED_RED){
+            psLeds->pfRedOn();
+        }
+        else{
+            psLeds->pfRedOff();
+        }
+    }
+    if(ui8Changed & SEAT_LED_GREEN){
+        if(ui8Leds & SEAT_LED_GREEN){
+            psLeds->pfGreenOn();
+        }
+        else{
+            psLeds->pfGreenOff();
+        }
+    }
+    if(ui8Changed & SEAT_LED_BLUE){
+        if(ui8Leds & SEAT_LED_BLUE){
+            psLeds->pfBlueOn();
+        }
+        else{
+            psLeds->pfBlueOff();
+        }
+    }
+    psRuntime->ui8Leds = ui8Leds;
+}
+
+void SEAT_init(SystemStateStructureType *psSystemState)
+{
+    uint8 ui8Seat;
+    uint32 ui32Now = GPTM_WTimer1Read();
+
+    psSeatSystemState = psSystemState;
+    ui32SeatEventMask = 0;
+
+    for(ui8Seat = 0; ui8Seat < SEAT_BUTTON_COUNT; ui8Seat++){
+        GESTURE_reset(&psSeatGestures[ui8Seat]);
+    }
+
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++){
+        uint8 ui8Channel = psSeatConfig[ui8Seat].ui8SensorChannel;
+
+        psSeatRuntime[ui8Seat].i16TempQ8 = POTS_getLatestTempQ8(ui8Channel);
+        psSeatRuntime[ui8Seat].ui32LastSampleTime = ui32Now;
+        psSeatRuntime[ui8Seat].bPidEngaged = FALSE;
+        /* The LEDs are turned off by main() once the drivers are initialized */
+        psSeatRuntime[ui8Seat].ui8Leds = 0;
+        pui16SeatAppliedPhase[ui8Seat] = SEAT_PHASE_UNKNOWN;
+
+        /* Temperature, sensor fault and level events of every seat wake up the control engine */
+        ui32SeatEventMask |= POTS_RANGE_EVENT(ui8Channel) | POTS_DIAG_EVENT(ui8Channel) |
+                             POTS_TEMP_EVENT(ui8Channel) | SEAT_LEVEL_EVENT(ui8Seat);
+    }
+}
+
+/* Event group bits the control engine has to wait for */
+uint32 SEAT_getEventMask(void)
+{
+    return ui32SeatEventMask;
+}
+
+/* Longest time the control engine may sleep: a PID seat needs its next period,
+ * otherwise only the sample age check has to run from time to time */
+uint32 SEAT_getTimeoutMs(void)
+{
+    uint8 ui8Seat;
+
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++){
+        if(psSeatRuntime[ui8Seat].bPidEngaged){
+            return SEAT_CONTROL_PERIOD_MS;
+        }
+    }
+    return SEAT_IDLE_PERIOD_MS;
+}
+
+static HeatingLevelType SEAT_nextLevel(HeatingLevelType eLevel)
+{
+    switch (eLevel) {
+    case HEATING_OFF:
+        return HEATING_LOW;
+    case HEATING_LOW:
+        return HEATING_MEDIUM;
+    case HEATING_MEDIUM:
+        return HEATING_HIGH;
+    default:
+        return HEATING_OFF;
+    }
+}
+
+/* Apply a gesture of a button to every seat using it, returns the SEAT_LEVEL_EVENT() bits of
+ * the seats whose level changed */
+static uint32 SEAT_applyGesture(uint8 ui8Button, uint8 ui8Gesture)
+{
+    uint32 ui32Events = 0;
+    uint8 ui8Seat;
+
+    if(ui8Gesture == GESTURE_NONE){
+        return 0;
+    }
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++){
+        SeatStateType *psState = &psSeatSystemState->Seats[ui8Seat];
+        HeatingLevelType eLevel = psState->heatingLevel;
+
+        if((psSeatConfig[ui8Seat].ui8Buttons & (1U << ui8Button)) == 0){
+            continue;
+        }
+        switch (ui8Gesture) {
+        case GESTURE_CLICK:
+            eLevel = SEAT_nextLevel(eLevel);
+            break;
+        case GESTURE_DOUBLE:
+            eLevel = HEATING_HIGH;
+            break;
+        case GESTURE_LONG:
+            eLevel = HEATING_OFF;
+            break;
+        case GESTURE_RAMP:
+            if(eLevel != HEATING_HIGH){
+                eLevel = SEAT_nextLevel(eLevel);
+            }
+            break;
+        default:
+            break;
+        }
+        if(eLevel != psState->heatingLevel){
+            psState->heatingLevel = eLevel;
+            ui32Events |= SEAT_LEVEL_EVENT(ui8Seat);
+        }
+    }
+    return ui32Events;
+}
+
+/* Debounced press or release of a level button, returns SEAT_LEVEL_EVENT() bits */
+uint32 SEAT_buttonEvent(uint8 ui8Button, boolean bPressed, uint32 ui32Timestamp)
+{
+    if(ui8Button >= SEAT_BUTTON_COUNT){
+        return 0;
+    }
+    return SEAT_applyGesture(ui8Button, GESTURE_event(&sSeatGestureConfig, &psSeatGestures[ui8Button],
+                                                      bPressed, ui32Timestamp));
+}
+
+/* Gestures completed by the deadlines that have passed, returns SEAT_LEVEL_EVENT() bits */
+uint32 SEAT_buttonTimeout(uint32 ui32Now)
+{
+    uint32 ui32Events = 0;
+    uint8 ui8Button;
+
+    for(ui8Button = 0; ui8Button < SEAT_BUTTON_COUNT; ui8Button++){
+        ui32Events |= SEAT_applyGesture(ui8Button, GESTURE_timeout(&sSeatGestureConfig, &psSeatGestures[ui8Button],
+                                                                   ui32Now));
+    }
+    return ui32Events;
+}
+
+/* Time until the next gesture deadline of any button */
+uint32 SEAT_getButtonTimeoutMs(uint32 ui32Now)
+{
+    uint32 ui32TimeoutMs = SEAT_NO_TIMEOUT;
+    uint8 ui8Button;
+
+    for(ui8Button = 0; ui8Button < SEAT_BUTTON_COUNT; ui8Button++){
+        uint32 ui32LeftMs = GESTURE_getTimeoutMs(&psSeatGestures[ui8Button], ui32Now);
+
+        if(ui32LeftMs < ui32TimeoutMs){
+            ui32TimeoutMs = ui32LeftMs;
+        }
+    }
+    return ui32TimeoutMs;
+}
+
+static HeaterStateType SEAT_dutyToHeaterState(uint16 ui16Duty)
+{
+    if(ui16Duty == 0){
+        return HEATER_OFF;
+    }
+    if(ui16Duty <= SEAT_DUTY_LOW){
+        return HEATER_LOW;
+    }
+    if(ui16Duty <= SEAT_DUTY_MEDIUM){
+        return HEATER_MEDIUM;
+    }
+    return HEATER_HIGH;
+}
+
+/* Closed loop control of a healthy seat, the duty is only recomputed once per control period */
+static void SEAT_runPid(uint8 ui8Seat, uint32 ui32Now, uint8 ui8DesiredTempValueC)
+{
+    const SEAT_ConfigType *psConfig = &psSeatConfig[ui8Seat];
+    SEAT_RuntimeType *psRuntime = &psSeatRuntime[ui8Seat];
+    SeatStateType *psState = &psSeatSystemState->Seats[ui8Seat];
+
+    if(psState->heatingLevel == HEATING_OFF){
+        psRuntime->bPidEngaged = FALSE;
+        psState->ui16RequestedDutyQ15 = 0;
+    }
+    else{
+        if(!psRuntime->bPidEngaged){
+            PID_reset(&psRuntime->sPid, psRuntime->i16TempQ8);
+            psRuntime->ui32PidDeadline = ui32Now;
+            psRuntime->bPidEngaged = TRUE;
+        }
+        if((sint32)(ui32Now - psRuntime->ui32PidDeadline) >= -(sint32)(SEAT_PID_PERIOD_TOLERANCE_MS * GPTM_TIMESTAMP_TICKS_PER_MS)){
+            psState->ui16RequestedDutyQ15 = PID_update(psConfig->psPid, &psRuntime->sPid,
+                                                    (sint16)(ui8DesiredTempValueC << POTS_TEMP_Q8_SHIFT),
+                                                    psRuntime->i16TempQ8);
+            psRuntime->ui32PidDeadline += SEAT_CONTROL_PERIOD_MS * GPTM_TIMESTAMP_TICKS_PER_MS;
+            /* Resynchronize instead of running a burst of catch-up periods */
+            if((sint32)(ui32Now - psRuntime->ui32PidDeadline) >= 0){
+                psRuntime->ui32PidDeadline = ui32Now + SEAT_CONTROL_PERIOD_MS * GPTM_TIMESTAMP_TICKS_PER_MS;
+            }
+        }
+    }
+
+    psState->heaterState = SEAT_dutyToHeaterState(psState->ui16RequestedDutyQ15);
+    SEAT_applyLeds(ui8Seat, pui8SeatPidLedsOn[psState->heaterState],
+                   (uint8)(~pui8SeatPidLedsOn[psState->heaterState]) & (SEAT_LED_RED | SEAT_LED_GREEN | SEAT_LED_BLUE));
+}
+
+/* Read the newest temperature of the seat and select its heater intensity */
+void SEAT_adjustHeater(uint8 ui8Seat, uint32 ui32Now)
+{
+    const SEAT_ConfigType *psConfig = &psSeatConfig[ui8Seat];
+    SEAT_RuntimeType *psRuntime = &psSeatRuntime[ui8Seat];
+    SeatStateType *psState = &psSeatSystemState->Seats[ui8Seat];
+    uint8 ui8DesiredTempValueC = psConfig->pui8SetpointsC[psState->heatingLevel];
+    uint8 ui8CurrentTempValueC;
+    uint32 ui32SamplesCount;
+    boolean bSampleFresh;
+
+    /* Drain the samples produced by the ADC stream since the last activation, the newest one is used */
+    while((ui32SamplesCount = POTS_readSamples(psConfig->ui8SensorChannel, psSeatSamples, SEAT_SAMPLES_BATCH)) != 0){
+        psRuntime->i16TempQ8 = psSeatSamples[ui32SamplesCount - 1].i16TempQ8;
+        psRuntime->ui32LastSampleTime = psSeatSamples[ui32SamplesCount - 1].ui32Timestamp;
+    }
+    /* Signed age: a sample pushed after ui32Now was taken is newer than the activation */
+    bSampleFresh = (sint32)(ui32Now - psRuntime->ui32LastSampleTime) <= (sint32)(SEAT_SAMPLE_MAX_AGE_MS * GPTM_TIMESTAMP_TICKS_PER_MS);
+    ui8CurrentTempValueC = (psRuntime->i16TempQ8 < 0) ? 0 : (uint8)(psRuntime->i16TempQ8 >> POTS_TEMP_Q8_SHIFT);
+    psState->ui8TempValueC = ui8CurrentTempValueC;
+
+    /* The validity window is watched by the ADC digital comparators, the
+     * plausibility checks run on every sample of the acquisition stream and
+     * a stalled stream is caught by the age of the newest sample */
+    if(bSampleFresh && POTS_isChannelHealthy(psConfig->ui8SensorChannel)){
+
+        if(psConfig->ui8ControlMode == SEAT_CONTROL_PID){
+            SEAT_runPid(ui8Seat, ui32Now, ui8DesiredTempValueC);
+        }
+        else{
+            uint8 ui8Entry = SEAT_fsmStep(psState->heaterState, psState->heatingLevel,
+                                          ui8DesiredTempValueC, ui8CurrentTempValueC);
+
+            psState->heaterState = SEAT_FSM_NEXT_STATE(ui8Entry);
+            SEAT_applyLeds(ui8Seat, SEAT_FSM_LEDS_ON(ui8Entry), SEAT_FSM_LEDS_OFF(ui8Entry));
+        }
+    }
+    else{
+        psState->heaterState = HEATER_OFF;
+        psRuntime->bPidEngaged = FALSE;
+        SEAT_applyLeds(ui8Seat, SEAT_LED_RED, SEAT_LED_GREEN | SEAT_LED_BLUE);
+    }
+
+    if(psConfig->ui8ControlMode != SEAT_CONTROL_PID || psState->heaterState == HEATER_OFF){
+        psState->ui16RequestedDutyQ15 = pui16SeatHeaterDuty[psState->heaterState];
+    }
+
+}
+
+/* Share the supply between the duties requested by all the seats and apply the grants,
+ * the PWM of a heater is only reprogrammed when its pulse changed */
+void SEAT_applyPower(void)
+{
+    uint8 ui8Seat;
+
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++){
+        pui16SeatRequestedDuty[ui8Seat] = psSeatSystemState->Seats[ui8Seat].ui16RequestedDutyQ15;
+    }
+
+    POWER_arbitrate(&sSeatPowerConfig, pui16SeatRequestedDuty, pui16SeatGrantedDuty, pui16SeatPhase);
+
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++){
+        const SEAT_ConfigType *psConfig = &psSeatConfig[ui8Seat];
+
+        psSeatSystemState->Seats[ui8Seat].ui16HeaterDutyQ15 = pui16SeatGrantedDuty[ui8Seat];
+        if((pui16SeatGrantedDuty[ui8Seat] != pui16SeatAppliedDuty[ui8Seat]) ||
+           (pui16SeatPhase[ui8Seat] != pui16SeatAppliedPhase[ui8Seat])){
+            HEATER_setPulse(psConfig->ui8HeaterOutput, pui16SeatGrantedDuty[ui8Seat], pui16SeatPhase[ui8Seat]);
+            POTS_diagSetHeating(psConfig->ui8SensorChannel, pui16SeatGrantedDuty[ui8Seat] != 0);
+            pui16SeatAppliedDuty[ui8Seat] = pui16SeatGrantedDuty[ui8Seat];
+            pui16SeatAppliedPhase[ui8Seat] = pui16SeatPhase[ui8Seat];
+        }
+    }
+}
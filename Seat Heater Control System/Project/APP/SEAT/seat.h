@@ -0,0 +1,98 @@
+/*
+ * seat.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef APP_SEAT_SEAT_H_
+#define APP_SEAT_SEAT_H_
+
+#include "std_types.h"
+#include <heatingsystem.h>
+#include "APP/PID/pid.h"
+#include "APP/POWER/power.h"
+#include "APP/GESTURE/gesture.h"
+
+/* Period of the PID of an engaged seat */
+#define SEAT_CONTROL_PERIOD_MS     (100U)
+/* Longest sleep of the control engine when no seat runs its PID: nothing is recomputed
+ * without an event, this only keeps the sample age check of every seat alive */
+#define SEAT_IDLE_PERIOD_MS        (1000U)
+
+/* Event group bit set by the input side when the heating level of a seat changed, the
+ * seats use the bits following the ones of the POTS driver (HAL/POTS/pots.h) */
+#define SEAT_LEVEL_EVENT(seat)     (1U << (POTS_EVENT_BITS + (seat)))
+
+/* Number of stream samples drained at once from the ring of a seat */
+#define SEAT_SAMPLES_BATCH         (4U)
+/* A seat whose newest sample is older than this is treated as faulty, a steady sensor
+ * still gets a sample every POTS_SAMPLE_KEEPALIVE_MS */
+#define SEAT_SAMPLE_MAX_AGE_MS     (POTS_SAMPLE_KEEPALIVE_MS + 250U)
+
+/* Level buttons, every button runs its own gesture recognizer (APP/GESTURE) with the
+ * thresholds of sSeatGestureConfig and acts on each seat it is configured for:
+ * click  --> next level, OFF --> LOW --> MEDIUM --> HIGH --> OFF
+ * double --> HIGH
+ * long   --> OFF
+ * ramp   --> one level up per ramp period, stops at HIGH */
+#define SEAT_BUTTON_COUNT          (8U)    /* bits of SEAT_ConfigType.ui8Buttons */
+/* Returned by SEAT_getButtonTimeoutMs() when no gesture is pending */
+#define SEAT_NO_TIMEOUT            GESTURE_NO_TIMEOUT
+
+/* Heater control modes, selected per seat in psSeatConfig[]:
+ * SEAT_CONTROL_THRESHOLD --> the four discrete heater states chosen from the gap to the setpoint
+ * SEAT_CONTROL_PID       --> closed loop PI(D) driving a continuous duty cycle */
+#define SEAT_CONTROL_THRESHOLD     0
+#define SEAT_CONTROL_PID           1
+
+/* The PID runs once per SEAT_CONTROL_PERIOD_MS, an activation up to SEAT_PID_PERIOD_TOLERANCE_MS
+ * early (tick rounding of the engine timeout) counts as on time, earlier event wakeups
+ * keep the previous duty. A seat in SEAT_CONTROL_THRESHOLD mode is only recomputed on events */
+#define SEAT_PID_PERIOD_TOLERANCE_MS   (10U)
+
+/* Duty cycle of each discrete heater state, a PID duty is shown as the nearest state above it */
+#define SEAT_DUTY_LOW              ((uint16)(PID_DUTY_MAX / 3))
+#define SEAT_DUTY_MEDIUM           ((uint16)((2 * PID_DUTY_MAX) / 3))
+#define SEAT_DUTY_HIGH             ((uint16)PID_DUTY_MAX)
+
+/* Indicator colors, used as bit masks in the LED patterns */
+#define SEAT_LED_RED               (0x01U)
+#define SEAT_LED_GREEN             (0x02U)
+#define SEAT_LED_BLUE              (0x04U)
+
+/* Output driver of a seat, one instance is shared by every seat wired to the same LEDs */
+typedef struct {
+    void (*pfRedOn)(void);
+    void (*pfRedOff)(void);
+    void (*pfGreenOn)(void);
+    void (*pfGreenOff)(void);
+    void (*pfBlueOn)(void);
+    void (*pfBlueOff)(void);
+}SEAT_LedDriverType;
+
+/* Static description of a heated zone */
+typedef struct {
+    uint8 ui8SensorChannel;                 /* POTS channel of the temperature sensor */
+    uint8 ui8HeaterOutput;                  /* HEATER PWM output driving the seat heater */
+    uint8 ui8Buttons;                       /* level buttons, INPUT_MASK() bits of HAL/INPUT */
+    const SEAT_LedDriverType *psLeds;       /* heater state indicator */
+    const uint8 *pui8SetpointsC;            /* desired temperature indexed by HeatingLevelType */
+    uint8 ui8ControlMode;                   /* SEAT_CONTROL_THRESHOLD or SEAT_CONTROL_PID */
+    const PID_ConfigType *psPid;            /* gains, only used in SEAT_CONTROL_PID mode */
+}SEAT_ConfigType;
+
+extern const SEAT_ConfigType psSeatConfig[SEAT_COUNT];
+extern const POWER_ConfigType sSeatPowerConfig;
+extern const GESTURE_ConfigType sSeatGestureConfig;
+
+void SEAT_init(SystemStateStructureType *psSystemState);
+uint32 SEAT_getEventMask(void);
+uint32 SEAT_getTimeoutMs(void);
+uint32 SEAT_buttonEvent(uint8 ui8Button, boolean bPressed, uint32 ui32Timestamp);
+uint32 SEAT_buttonTimeout(uint32 ui32Now);
+uint32 SEAT_getButtonTimeoutMs(uint32 ui32Now);
+void SEAT_adjustHeater(uint8 ui8Seat, uint32 ui32Now);
+void SEAT_applyPower(void);
+
+#endif /* APP_SEAT_SEAT_H_ */
@@ -0,0 +1,81 @@
+/*
+ * seat_cfg.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include "APP/SEAT/seat.h"
+#include <HAL/POTS/pots.h>
+#include "HAL/RGB_LED/rgb.h"
+#include "HAL/HEATER/heater.h"
+#include "HAL/INPUT/input.h"
+#include "gpio.h"
+
+/* Desired temperature in °C for each heating level, HEATING_OFF never reaches the controller */
+static const uint8 pui8SeatSetpointsC[] = {
+    0,      /* HEATING_OFF    */
+    25,     /* HEATING_LOW    */
+    30,     /* HEATING_MEDIUM */
+    35,     /* HEATING_HIGH   */
+};
+
+/* Closed loop gains for a SEAT_CONTROL_PERIOD_MS period: full power from 5°C below the
+ * setpoint, the integrator trims the steady state error within a few seconds */
+static const PID_ConfigType sSeatPidGains = {
+    PID_GAIN(0.2),          /* Kp: duty per °C               */
+    PID_GAIN(0.004),        /* Ki: duty per °C per period     */
+    PID_GAIN(0.0),          /* Kd: duty per °C/period         */
+    PID_GAIN(0.25),         /* Kb: anti-windup bleed per period */
+    0,                      /* integrator min (Q15 duty)      */
+    PID_DUTY_MAX / 2,       /* integrator max (Q15 duty)      */
+};
+
+/* Level button gestures, a click is only taken once the double press gap has elapsed */
+const GESTURE_ConfigType sSeatGestureConfig = {
+    1000,   /* ms held --> OFF                      */
+    300,    /* ms between the presses of a double   */
+    400,    /* ms held on the second press --> ramp */
+    500,    /* ms per ramp step                     */
+};
+
+/* External RGB LED on PB1..PB3 */
+static const SEAT_LedDriverType sSeatRgbLeds = {
+    RGB_RedLedOn,   RGB_RedLedOff,
+    RGB_GreenLedOn, RGB_GreenLedOff,
+    RGB_BlueLedOn,  RGB_BlueLedOff,
+};
+
+/* TivaC built-in LED on PF1..PF3 */
+static const SEAT_LedDriverType sSeatBuiltinLeds = {
+    GPIO_RedLedOn,   GPIO_RedLedOff,
+    GPIO_GreenLedOn, GPIO_GreenLedOff,
+    GPIO_BlueLedOn,  GPIO_BlueLedOff,
+};
+
+/* Heater current at full duty, indexed by seat */
+static const uint16 pui16SeatHeaterCurrentMa[SEAT_COUNT] = {
+    5000,   /* seat 1 */
+    5000,   /* seat 2 */
+};
+
+/* Driver seat first: it keeps its full request while the passenger seat gets what is left */
+static const uint8 pui8SeatPowerOrder[SEAT_COUNT] = {
+    0,      /* seat 1 (driver)    */
+    1,      /* seat 2 (passenger) */
+};
+
+/* Budget granted by the BCM for all the seat heaters */
+const POWER_ConfigType sSeatPowerConfig = {
+    7500,                   /* mA, one and a half heaters */
+    POWER_POLICY_PRIORITY,
+    SEAT_COUNT,
+    pui16SeatHeaterCurrentMa,
+    pui8SeatPowerOrder,
+};
+
+const SEAT_ConfigType psSeatConfig[SEAT_COUNT] = {
+    /* Seat 1 level can be changed from the external button or from SW1 */
+    { POTS_SEAT1_CHANNEL, HEATER_SEAT1_OUTPUT, INPUT_MASK(INPUT_SW1) | INPUT_MASK(INPUT_EXT), &sSeatRgbLeds,     pui8SeatSetpointsC, SEAT_CONTROL_THRESHOLD, &sSeatPidGains },
+    { POTS_SEAT2_CHANNEL, HEATER_SEAT2_OUTPUT, INPUT_MASK(INPUT_SW2),                         &sSeatBuiltinLeds, pui8SeatSetpointsC, SEAT_CONTROL_THRESHOLD, &sSeatPidGains },
+};
@@ -0,0 +1,24 @@
+/*
+ * seat_fsm.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include "APP/SEAT/seat_fsm.h"
+
+/* Heater decision of a seat in SEAT_CONTROL_THRESHOLD mode: the saturated error selects the
+ * column of the generated table (Tools/gen_seat_fsm.py), the current state the row */
+uint8 SEAT_fsmStep(HeaterStateType eState, HeatingLevelType eLevel, uint8 ui8DesiredTempC, uint8 ui8CurrentTempC)
+{
+    sint16 i16ErrorC = (sint16)ui8DesiredTempC - ui8CurrentTempC;
+
+    if((eLevel == HEATING_OFF) || (i16ErrorC < 0)){
+        i16ErrorC = 0;
+    }
+    if(i16ErrorC >= SEAT_FSM_ERROR_BANDS){
+        i16ErrorC = SEAT_FSM_ERROR_BANDS - 1;
+    }
+
+    return pui8SeatFsmTable[eState][i16ErrorC];
+}
@@ -0,0 +1,22 @@
+/*
+ * seat_fsm.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef APP_SEAT_SEAT_FSM_H_
+#define APP_SEAT_SEAT_FSM_H_
+
+#include "std_types.h"
+#include <heatingsystem.h>
+#include "APP/SEAT/seat_fsm_table.h"
+
+/* Fields of the entry returned by SEAT_fsmStep() */
+#define SEAT_FSM_NEXT_STATE(entry)  ((HeaterStateType)((entry) & SEAT_FSM_STATE_MASK))
+#define SEAT_FSM_LEDS_ON(entry)     ((uint8)(((entry) >> SEAT_FSM_LEDS_ON_SHIFT) & SEAT_FSM_LEDS_MASK))
+#define SEAT_FSM_LEDS_OFF(entry)    ((uint8)(((entry) >> SEAT_FSM_LEDS_OFF_SHIFT) & SEAT_FSM_LEDS_MASK))
+
+uint8 SEAT_fsmStep(HeaterStateType eState, HeatingLevelType eLevel, uint8 ui8DesiredTempC, uint8 ui8CurrentTempC);
+
+#endif /* APP_SEAT_SEAT_FSM_H_ */
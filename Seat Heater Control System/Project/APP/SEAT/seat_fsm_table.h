@@ -0,0 +1,30 @@
+/*
+ * seat_fsm_table.h
+ *
+ *  Generated by Tools/gen_seat_fsm.py, do not edit by hand.
+ */
+
+#ifndef APP_SEAT_SEAT_FSM_TABLE_H_
+#define APP_SEAT_SEAT_FSM_TABLE_H_
+
+#include "std_types.h"
+
+/* Error bands: 0 --> no demand, n --> n C below the setpoint, the last band also
+ * holds every larger error */
+#define SEAT_FSM_ERROR_BANDS        11
+
+/* Entry layout: next HeaterStateType | LEDs to turn on | LEDs to turn off (SEAT_LED_* masks) */
+#define SEAT_FSM_STATE_MASK         0x03
+#define SEAT_FSM_LEDS_ON_SHIFT      2
+#define SEAT_FSM_LEDS_OFF_SHIFT     5
+#define SEAT_FSM_LEDS_MASK          0x07
+
+/* Indexed by [current heater state][error band] */
+static const uint8 pui8SeatFsmTable[4][SEAT_FSM_ERROR_BANDS] = {
+    { 0xE0, 0xC0, 0xC0, 0xC0, 0x39, 0x72, 0x72, 0x72, 0x72, 0x72, 0xAB },   /* HEATER_OFF */
+    { 0xE0, 0xC0, 0x39, 0x39, 0x39, 0x72, 0x72, 0x72, 0x72, 0x72, 0xAB },   /* HEATER_LOW */
+    { 0xE0, 0xC0, 0x39, 0x39, 0x39, 0x72, 0x72, 0x72, 0x72, 0x72, 0xAB },   /* HEATER_MEDIUM */
+    { 0xE0, 0xC0, 0x39, 0x39, 0x39, 0x72, 0x72, 0x72, 0x72, 0x72, 0xAB }    /* HEATER_HIGH */
+};
+
+#endif /* APP_SEAT_SEAT_FSM_TABLE_H_ */
@@ -0,0 +1,177 @@
+/*
+ * telemetry.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include <string.h>
+#include "APP/TELEMETRY/telemetry.h"
+#include "crc16.h"
+
+/* Every published field serialized back to back: the status fields, then the seats. Both
+ * record types are built from it and the delta compares it with the last one published */
+#define TELEMETRY_STATUS_SIZE           5
+#define TELEMETRY_IMAGE_SIZE            (TELEMETRY_STATUS_SIZE + (TELEMETRY_SEAT_SIZE * SEAT_COUNT))
+
+/* Delta with every field changed, one mask byte more per seat than the keyframe */
+#define TELEMETRY_DELTA_MAX_SIZE        (TELEMETRY_DELTA_HEADER_SIZE + TELEMETRY_IMAGE_SIZE + SEAT_COUNT + TELEMETRY_CRC_SIZE)
+
+/* Bytes of every field of the image, in the bit order of the delta masks */
+static const uint8 pui8StatusFieldSize[TELEMETRY_STATUS_FIELDS] = { 1, 2, 2 };
+static const uint8 pui8SeatFieldSize[TELEMETRY_SEAT_FIELDS] = { 1, 1, 1, 2, 2 };
+
+static uint16 ui16TelemetrySequence = 0;
+
+/* Image of the last record sent, the delta base */
+static uint8 pui8TelemetryPublished[TELEMETRY_IMAGE_SIZE];
+static boolean bTelemetryPublished = FALSE;
+
+static uint8 *TELEMETRY_put16(uint8 *pui8Out, uint16 ui16Value)
+{
+    pui8Out[0] = (uint8)ui16Value;
+    pui8Out[1] = (uint8)(ui16Value >> 8);
+    return pui8Out + 2;
+}
+
+static uint8 *TELEMETRY_put32(uint8 *pui8Out, uint32 ui32Value)
+{
+    pui8Out = TELEMETRY_put16(pui8Out, (uint16)ui32Value);
+    return TELEMETRY_put16(pui8Out, (uint16)(ui32Value >> 16));
+}
+
+/* Field by field: the layout does not depend on the struct packing of the compiler */
+static void TELEMETRY_buildImage(const SystemStateStructureType *psSystemState,
+                                 const TELEMETRY_StatusType *psStatus, uint8 *pui8Image)
+{
+    uint8 ui8Seat;
+
+    *pui8Image++ = psStatus->ui8CpuLoadPercent;
+    pui8Image = TELEMETRY_put16(pui8Image, psStatus->ui16GrantedMa);
+    pui8Image = TELEMETRY_put16(pui8Image, psStatus->ui16RequestedMa);
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++){
+        const SeatStateType *psSeat = &psSystemState->Seats[ui8Seat];
+
+        *pui8Image++ = psSeat->ui8TempValueC;
+        *pui8Image++ = (uint8)psSeat->heatingLevel;
+        *pui8Image++ = (uint8)psSeat->heaterState;
+        pui8Image = TELEMETRY_put16(pui8Image, psSeat->ui16RequestedDutyQ15);
+        pui8Image = TELEMETRY_put16(pui8Image, psSeat->ui16HeaterDutyQ15);
+    }
+}
+
+static uint8 *TELEMETRY_putHeader(uint8 *pui8Out, uint8 ui8Type, const TELEMETRY_StatusType *psStatus)
+{
+    *pui8Out++ = TELEMETRY_VERSION;
+    *pui8Out++ = ui8Type;
+    pui8Out = TELEMETRY_put16(pui8Out, ui16TelemetrySequence++);
+    return TELEMETRY_put32(pui8Out, psStatus->ui32TimestampMs);
+}
+
+/* Append the CRC to a record, then COBS encode it between two delimiters */
+static uint32 TELEMETRY_frame(uint8 *pui8Record, uint32 ui32Length, uint8 *pui8Frame)
+{
+    TELEMETRY_put16(&pui8Record[ui32Length], CRC16_update(CRC16_INIT, pui8Record, ui32Length));
+    ui32Length += TELEMETRY_CRC_SIZE;
+
+    pui8Frame[0] = COBS_DELIMITER;
+    ui32Length = COBS_encode(pui8Record, ui32Length, &pui8Frame[1]) + 1;
+    pui8Frame[ui32Length++] = COBS_DELIMITER;
+    return ui32Length;
+}
+
+static uint32 TELEMETRY_stateFrame(const uint8 *pui8Image, const TELEMETRY_StatusType *psStatus,
+                                   uint8 *pui8Frame)
+{
+    uint8 pui8Record[TELEMETRY_STATE_SIZE(SEAT_COUNT)];
+    uint8 *pui8Out = TELEMETRY_putHeader(pui8Record, TELEMETRY_RECORD_STATE, psStatus);
+
+    *pui8Out++ = pui8Image[0];
+    *pui8Out++ = SEAT_COUNT;
+    memcpy(pui8Out, &pui8Image[1], TELEMETRY_IMAGE_SIZE - 1);
+    pui8Out += TELEMETRY_IMAGE_SIZE - 1;
+
+    memcpy(pui8TelemetryPublished, pui8Image, TELEMETRY_IMAGE_SIZE);
+    bTelemetryPublished = TRUE;
+    return TELEMETRY_frame(pui8Record, (uint32)(pui8Out - pui8Record), pui8Frame);
+}
+
+/* Copy the fields of the image that differ from the last record, returns their bit mask */
+static uint8 TELEMETRY_putChanged(const uint8 *pui8Image, uint32 *pui32Offset, const uint8 *pui8FieldSize,
+                                  uint8 ui8Fields, uint8 **ppui8Out)
+{
+    uint8 ui8Mask = 0;
+    uint8 ui8Field;
+
+    for(ui8Field = 0; ui8Field < ui8Fields; ui8Field++){
+        uint32 ui32Offset = *pui32Offset;
+        uint8 ui8Size = pui8FieldSize[ui8Field];
+
+        if(memcmp(&pui8Image[ui32Offset], &pui8TelemetryPublished[ui32Offset], ui8Size) != 0){
+            memcpy(*ppui8Out, &pui8Image[ui32Offset], ui8Size);
+            *ppui8Out += ui8Size;
+            ui8Mask |= (uint8)(1U << ui8Field);
+        }
+        *pui32Offset = ui32Offset + ui8Size;
+    }
+    return ui8Mask;
+}
+
+/* Serialize the state of every seat into a delimited keyframe, pui8Frame must hold
+ * TELEMETRY_MAX_FRAME_SIZE bytes. Returns the frame length */
+uint32 TELEMETRY_buildStateFrame(const SystemStateStructureType *psSystemState,
+                                 const TELEMETRY_StatusType *psStatus, uint8 *pui8Frame)
+{
+    uint8 pui8Image[TELEMETRY_IMAGE_SIZE];
+
+    TELEMETRY_buildImage(psSystemState, psStatus, pui8Image);
+    return TELEMETRY_stateFrame(pui8Image, psStatus, pui8Frame);
+}
+
+/* Serialize the fields changed since the last record into a delimited frame, pui8Frame
+ * must hold TELEMETRY_MAX_FRAME_SIZE bytes. Returns 0 without a change, nothing is sent
+ * and no sequence number is taken. Before the first keyframe, or when the delta would
+ * not be smaller, a keyframe is built instead */
+uint32 TELEMETRY_buildDeltaFrame(const SystemStateStructureType *psSystemState,
+                                 const TELEMETRY_StatusType *psStatus, uint8 *pui8Frame)
+{
+    uint8 pui8Image[TELEMETRY_IMAGE_SIZE];
+    uint8 pui8Record[TELEMETRY_DELTA_MAX_SIZE];
+    uint8 *pui8Out = &pui8Record[TELEMETRY_DELTA_HEADER_SIZE];
+    uint32 ui32Offset = 0;
+    uint8 ui8StatusMask;
+    uint8 ui8SeatMask = 0;
+    uint8 ui8Seat;
+
+    TELEMETRY_buildImage(psSystemState, psStatus, pui8Image);
+    if(bTelemetryPublished == FALSE){
+        return TELEMETRY_stateFrame(pui8Image, psStatus, pui8Frame);
+    }
+
+    ui8StatusMask = TELEMETRY_putChanged(pui8Image, &ui32Offset, pui8StatusFieldSize, TELEMETRY_STATUS_FIELDS,
+                                         &pui8Out);
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++){
+        uint8 *pui8FieldMask = pui8Out++;
+
+        *pui8FieldMask = TELEMETRY_putChanged(pui8Image, &ui32Offset, pui8SeatFieldSize, TELEMETRY_SEAT_FIELDS,
+                                              &pui8Out);
+        if(*pui8FieldMask == 0){
+            pui8Out--;
+        }else{
+            ui8SeatMask |= (uint8)(1U << ui8Seat);
+        }
+    }
+
+    if((ui8StatusMask == 0) && (ui8SeatMask == 0)){
+        return 0;
+    }
+    if((uint32)(pui8Out - pui8Record) >= (TELEMETRY_STATE_SIZE(SEAT_COUNT) - TELEMETRY_CRC_SIZE)){
+        return TELEMETRY_stateFrame(pui8Image, psStatus, pui8Frame);
+    }
+
+    TELEMETRY_putHeader(pui8Record, TELEMETRY_RECORD_DELTA, psStatus);
+    pui8Record[8] = ui8StatusMask;
+    pui8Record[9] = ui8SeatMask;
+    memcpy(pui8TelemetryPublished, pui8Image, TELEMETRY_IMAGE_SIZE);
+    return TELEMETRY_frame(pui8Record, (uint32)(pui8Out - pui8Record), pui8Frame);
+}
@@ -0,0 +1,85 @@
+/*
+ * telemetry.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef APP_TELEMETRY_TELEMETRY_H_
+#define APP_TELEMETRY_TELEMETRY_H_
+
+#include "std_types.h"
+#include <heatingsystem.h>
+#include "cobs.h"
+
+/* Binary status records, little endian, sent instead of the text dump. Bump the version
+ * whenever the layout changes, the host decoder (Tools/telemetry_decode.cpp) rejects the
+ * versions it does not know.
+ *
+ * TELEMETRY_RECORD_STATE, keyframe with every field:
+ *  offset  size  field
+ *       0     1  TELEMETRY_VERSION
+ *       1     1  record type
+ *       2     2  sequence number, wraps, shared by both record types
+ *       4     4  timestamp in ms since start up
+ *       8     1  CPU load in %
+ *       9     1  number of seats N
+ *      10     2  heater current granted by the power arbiter in mA
+ *      12     2  heater current requested in mA
+ *      14  7 * N per seat: temperature C, HeatingLevelType, HeaterStateType,
+ *                requested duty Q15 (2), applied duty Q15 (2)
+ *  14 + 7 * N 2  CRC-16/CCITT-FALSE of all the bytes above (Common/crc16.h)
+ *
+ * TELEMETRY_RECORD_DELTA, only the fields changed since the previous record:
+ *       0     8  version, type, sequence and timestamp as above
+ *       8     1  changed status fields, bit 0 CPU load, 1 granted mA, 2 requested mA
+ *       9     1  seats with a changed field, bit 0 is the first seat
+ *      10        the changed status fields in bit order, then for every seat of the seat
+ *                mask one byte of changed fields (bit 0 temperature, 1 level, 2 heater
+ *                state, 3 requested duty, 4 applied duty) followed by these fields
+ *       .     2  CRC as above
+ *
+ * A delta only applies on top of the record with the previous sequence number: after a
+ * gap the receiver waits for the next keyframe. A delta is never larger than a keyframe,
+ * TELEMETRY_buildDeltaFrame() sends a keyframe instead.
+ *
+ * TELEMETRY_RECORD_LOG frames carry the deferred log (APP/LOG/log.h) on the same stream,
+ * with a sequence number of their own.
+ *
+ * On the wire a record is COBS encoded and wrapped in two delimiters: the leading one
+ * cuts off any text printed in between, so a record is never merged with it */
+#define TELEMETRY_VERSION               1
+#define TELEMETRY_RECORD_STATE          1
+#define TELEMETRY_RECORD_DELTA          2
+#define TELEMETRY_RECORD_LOG            3       /* deferred log records, layout in APP/LOG/log.h */
+
+#define TELEMETRY_HEADER_SIZE           14
+#define TELEMETRY_SEAT_SIZE             7
+#define TELEMETRY_CRC_SIZE              2
+#define TELEMETRY_STATE_SIZE(seats)     (TELEMETRY_HEADER_SIZE + (TELEMETRY_SEAT_SIZE * (seats)) + TELEMETRY_CRC_SIZE)
+
+#define TELEMETRY_DELTA_HEADER_SIZE     10
+#define TELEMETRY_STATUS_FIELDS         3
+#define TELEMETRY_SEAT_FIELDS           5
+
+#if (SEAT_COUNT > 8)
+#error "The seat mask of TELEMETRY_RECORD_DELTA holds 8 seats"
+#endif
+
+/* Bytes a frame of TELEMETRY_buildStateFrame() or TELEMETRY_buildDeltaFrame() may take */
+#define TELEMETRY_MAX_FRAME_SIZE        (COBS_MAX_ENCODED_SIZE(TELEMETRY_STATE_SIZE(SEAT_COUNT)) + 2)
+
+/* Status shown next to the seats */
+typedef struct {
+    uint32 ui32TimestampMs;
+    uint8 ui8CpuLoadPercent;
+    uint16 ui16GrantedMa;
+    uint16 ui16RequestedMa;
+}TELEMETRY_StatusType;
+
+uint32 TELEMETRY_buildStateFrame(const SystemStateStructureType *psSystemState,
+                                 const TELEMETRY_StatusType *psStatus, uint8 *pui8Frame);
+uint32 TELEMETRY_buildDeltaFrame(const SystemStateStructureType *psSystemState,
+                                 const TELEMETRY_StatusType *psStatus, uint8 *pui8Frame);
+
+#endif /* APP_TELEMETRY_TELEMETRY_H_ */
@@ -0,0 +1,66 @@
+ /******************************************************************************
+ *
+ * Module: Common - COBS
+ *
+ * File Name: cobs.c
+ *
+ * Description: Consistent Overhead Byte Stuffing of binary frames
+ *
+ * Author: Ahmed Surror
+ *
+ *******************************************************************************/
+
+#include "cobs.h"
+
+/* pui8Encoded must hold COBS_MAX_ENCODED_SIZE(ui32Length) bytes, the delimiter is not
+ * added. Returns the encoded length */
+uint32 COBS_encode(const uint8 *pui8Data, uint32 ui32Length, uint8 *pui8Encoded)
+{
+    uint32 ui32Code = 0;        /* position of the code byte of the current run */
+    uint32 ui32Out = 1;
+    uint8 ui8Run = 1;
+    uint32 ui32In;
+
+    for(ui32In = 0; ui32In < ui32Length; ui32In++){
+        if(pui8Data[ui32In] != COBS_DELIMITER){
+            pui8Encoded[ui32Out++] = pui8Data[ui32In];
+            ui8Run++;
+        }
+        if((pui8Data[ui32In] == COBS_DELIMITER) || (ui8Run == 0xFF)){
+            /* A full run of 254 bytes is closed without an implied zero */
+            pui8Encoded[ui32Code] = ui8Run;
+            ui32Code = ui32Out++;
+            ui8Run = 1;
+        }
+    }
+    pui8Encoded[ui32Code] = ui8Run;
+    return ui32Out;
+}
+
+/* Frame without its delimiter, returns the decoded length or 0 if the frame is malformed.
+ * pui8Data must hold ui32Length bytes */
+uint32 COBS_decode(const uint8 *pui8Encoded, uint32 ui32Length, uint8 *pui8Data)
+{
+    uint32 ui32In = 0;
+    uint32 ui32Out = 0;
+
+    while(ui32In < ui32Length){
+        uint8 ui8Code = pui8Encoded[ui32In++];
+        uint8 ui8Index;
+
+        if((ui8Code == COBS_DELIMITER) || ((ui32In + ui8Code - 1U) > ui32Length)){
+            return 0;
+        }
+        for(ui8Index = 1; ui8Index < ui8Code; ui8Index++){
+            if(pui8Encoded[ui32In] == COBS_DELIMITER){
+                return 0;
+            }
+            pui8Data[ui32Out++] = pui8Encoded[ui32In++];
+        }
+        /* A run shorter than 254 stands for a zero, except at the very end */
+        if((ui8Code != 0xFF) && (ui32In < ui32Length)){
+            pui8Data[ui32Out++] = COBS_DELIMITER;
+        }
+    }
+    return ui32Out;
+}
@@ -0,0 +1,27 @@
+ /******************************************************************************
+ *
+ * Module: Common - COBS
+ *
+ * File Name: cobs.h
+ *
+ * Description: Consistent Overhead Byte Stuffing of binary frames
+ *
+ * Author: Ahmed Surror
+ *
+ *******************************************************************************/
+
+#ifndef COBS_H_
+#define COBS_H_
+
+#include "std_types.h"
+
+/* COBS removes every 0x00 from a frame at the cost of one byte per started run of 254
+ * bytes, so 0x00 can delimit the frames on a byte stream and a receiver resynchronizes on
+ * the next delimiter after any corruption */
+#define COBS_DELIMITER              0x00
+#define COBS_MAX_ENCODED_SIZE(len)  ((len) + ((len) / 254) + 1)
+
+uint32 COBS_encode(const uint8 *pui8Data, uint32 ui32Length, uint8 *pui8Encoded);
+uint32 COBS_decode(const uint8 *pui8Encoded, uint32 ui32Length, uint8 *pui8Data);
+
+#endif /* COBS_H_ */
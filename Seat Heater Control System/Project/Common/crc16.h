@@ -0,0 +1,26 @@
+ /******************************************************************************
+ *
+ * Module: Common - CRC16
+ *
+ * File Name: crc16.h
+ *
+ * Description: CRC-16/CCITT-FALSE of binary frames
+ *
+ * Author: Ahmed Surror
+ *
+ *******************************************************************************/
+
+#ifndef CRC16_H_
+#define CRC16_H_
+
+#include "std_types.h"
+
+/* CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF, no reflection, no final
+ * XOR. The TM4C123GH6PM has no CRC module (driverlib/crc.c drives the CCM of the TM4C129
+ * parts), so it is computed with a 512 byte table, one lookup per byte */
+#define CRC16_INIT              0xFFFFU
+#define CRC16_CHECK             0x29B1U     /* CRC of "123456789" */
+
+uint16 CRC16_update(uint16 ui16Crc, const uint8 *pui8Data, uint32 ui32Length);
+
+#endif /* CRC16_H_ */
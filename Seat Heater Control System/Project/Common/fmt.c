@@ -0,0 +1,147 @@
+ /******************************************************************************
+ *
+ * Module: Common - Formatting
+ *
+ * File Name: fmt.c
+ *
+ * Description: Integer and fixed point to decimal text into caller buffers
+ *
+ * Author: Ahmed Surror
+ *
+ *******************************************************************************/
+
+#include "fmt.h"
+
+/* "00" .. "99": two digits per division */
+static const uint8 pui8FmtDigitPairs[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const uint32 pui32FmtPowers10[FMT_U32_MAX_SIZE] = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+/* Number of decimal digits of the value, at least one */
+static uint8 FMT_countDigits(uint32 ui32Value)
+{
+    uint8 ui8Digits = 1;
+
+    while((ui8Digits < FMT_U32_MAX_SIZE) && (ui32Value >= pui32FmtPowers10[ui8Digits])){
+        ui8Digits++;
+    }
+    return ui8Digits;
+}
+
+/* Digits of the value written backwards, the last one just before pui8End */
+static uint8 *FMT_putDigits(uint8 *pui8End, uint32 ui32Value)
+{
+    while(ui32Value >= 100){
+        uint32 ui32Quotient = ui32Value / 100;
+        uint32 ui32Pair = (ui32Value - (ui32Quotient * 100)) * 2;
+
+        *--pui8End = pui8FmtDigitPairs[ui32Pair + 1];
+        *--pui8End = pui8FmtDigitPairs[ui32Pair];
+        ui32Value = ui32Quotient;
+    }
+    if(ui32Value >= 10){
+        *--pui8End = pui8FmtDigitPairs[(ui32Value * 2) + 1];
+        *--pui8End = pui8FmtDigitPairs[ui32Value * 2];
+    }else{
+        *--pui8End = (uint8)('0' + ui32Value);
+    }
+    return pui8End;
+}
+
+/* Unsigned decimal, at most FMT_U32_MAX_SIZE bytes */
+uint32 FMT_u32(uint8 *pui8Out, uint32 ui32Value)
+{
+    uint8 ui8Digits = FMT_countDigits(ui32Value);
+
+    FMT_putDigits(&pui8Out[ui8Digits], ui32Value);
+    return ui8Digits;
+}
+
+/* Signed decimal, at most FMT_S32_MAX_SIZE bytes */
+uint32 FMT_s32(uint8 *pui8Out, sint32 i32Value)
+{
+    if(i32Value < 0){
+        pui8Out[0] = '-';
+        /* Negated unsigned: also right for -2147483648 */
+        return 1 + FMT_u32(&pui8Out[1], 0UL - (uint32)i32Value);
+    }
+    return FMT_u32(pui8Out, (uint32)i32Value);
+}
+
+/* Lower case hexadecimal without prefix or leading zeros, at most FMT_X32_MAX_SIZE bytes */
+uint32 FMT_x32(uint8 *pui8Out, uint32 ui32Value)
+{
+    uint32 ui32Digits = 1;
+    uint32 ui32Index;
+
+    while((ui32Digits < FMT_X32_MAX_SIZE) && ((ui32Value >> (4 * ui32Digits)) != 0)){
+        ui32Digits++;
+    }
+    for(ui32Index = ui32Digits; ui32Index > 0; ui32Index--){
+        pui8Out[ui32Index - 1] = (uint8)"0123456789abcdef"[ui32Value & 0xF];
+        ui32Value >>= 4;
+    }
+    return ui32Digits;
+}
+
+/* Unsigned decimal right aligned on ui8Width bytes, filled on the left with ui8Pad (' ' for
+ * columns, '0' for fixed digits). A wider value is written whole, the width is a minimum */
+uint32 FMT_u32Pad(uint8 *pui8Out, uint32 ui32Value, uint8 ui8Width, uint8 ui8Pad)
+{
+    uint8 *pui8Start;
+
+    if(FMT_countDigits(ui32Value) >= ui8Width){
+        return FMT_u32(pui8Out, ui32Value);
+    }
+    pui8Start = FMT_putDigits(&pui8Out[ui8Width], ui32Value);
+    while(pui8Start > pui8Out){
+        *--pui8Start = ui8Pad;
+    }
+    return ui8Width;
+}
+
+/* Signed Q-format value (ui8FracBits fraction bits, at most FMT_Q_MAX_FRAC_BITS) with
+ * ui8Decimals digits after the point (at most FMT_Q_MAX_DECIMALS), rounded half away from
+ * zero, for example a Q8 temperature with one decimal or a Q15 duty times 100 as percent.
+ * At most FMT_Q32_MAX_SIZE bytes */
+uint32 FMT_q32(uint8 *pui8Out, sint32 i32Value, uint8 ui8FracBits, uint8 ui8Decimals)
+{
+    uint32 ui32Magnitude = (i32Value < 0) ? (0UL - (uint32)i32Value) : (uint32)i32Value;
+    uint32 ui32Scale = pui32FmtPowers10[ui8Decimals];
+    uint32 ui32Integer = ui32Magnitude >> ui8FracBits;
+    uint32 ui32Fraction = ui32Magnitude & ((1UL << ui8FracBits) - 1);
+    uint32 ui32Length = 0;
+
+    /* At most 2^16 * 10^4, the scaled fraction fits in 32 bits */
+    ui32Fraction *= ui32Scale;
+    if(ui8FracBits != 0){
+        ui32Fraction = (ui32Fraction + (1UL << (ui8FracBits - 1))) >> ui8FracBits;
+    }
+    if(ui32Fraction >= ui32Scale){
+        ui32Integer++;
+        ui32Fraction -= ui32Scale;
+    }
+
+    /* No "-0.0" for a value that rounds to zero */
+    if((i32Value < 0) && ((ui32Integer != 0) || (ui32Fraction != 0))){
+        pui8Out[ui32Length++] = '-';
+    }
+    ui32Length += FMT_u32(&pui8Out[ui32Length], ui32Integer);
+    if(ui8Decimals != 0){
+        pui8Out[ui32Length++] = '.';
+        ui32Length += FMT_u32Pad(&pui8Out[ui32Length], ui32Fraction, ui8Decimals, '0');
+    }
+    return ui32Length;
+}
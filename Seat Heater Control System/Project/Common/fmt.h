@@ -0,0 +1,39 @@
+ /******************************************************************************
+ *
+ * Module: Common - Formatting
+ *
+ * File Name: fmt.h
+ *
+ * Description: Integer and fixed point to decimal text into caller buffers
+ *
+ * Author: Ahmed Surror
+ *
+ *******************************************************************************/
+
+#ifndef FMT_H_
+#define FMT_H_
+
+#include "std_types.h"
+
+/* Every function writes the text at the start of pui8Out, without terminating '\0', and
+ * returns its length. Values are 32-bit: a division by 100 per two digits, done by the
+ * hardware divider of the Cortex-M4, where a 64-bit value would call the library division
+ * per digit. Nothing is allocated and no state is kept, any task may format concurrently */
+
+/* Largest text of each function, size the buffers with these */
+#define FMT_U32_MAX_SIZE        10      /* 4294967295 */
+#define FMT_S32_MAX_SIZE        11      /* -2147483648 */
+#define FMT_X32_MAX_SIZE        8       /* ffffffff */
+
+/* Q-format limits of FMT_q32(), the fraction is scaled in 32 bits */
+#define FMT_Q_MAX_FRAC_BITS     16
+#define FMT_Q_MAX_DECIMALS      4
+#define FMT_Q32_MAX_SIZE        (FMT_S32_MAX_SIZE + 1 + FMT_Q_MAX_DECIMALS)
+
+uint32 FMT_u32(uint8 *pui8Out, uint32 ui32Value);
+uint32 FMT_s32(uint8 *pui8Out, sint32 i32Value);
+uint32 FMT_x32(uint8 *pui8Out, uint32 ui32Value);
+uint32 FMT_u32Pad(uint8 *pui8Out, uint32 ui32Value, uint8 ui8Width, uint8 ui8Pad);
+uint32 FMT_q32(uint8 *pui8Out, sint32 i32Value, uint8 ui8FracBits, uint8 ui8Decimals);
+
+#endif /* FMT_H_ */
@@ -0,0 +1,61 @@
+ /******************************************************************************
+ *
+ * Module: Common - Sample Ring
+ *
+ * File Name: sample_ring.c
+ *
+ * Description: Wait-free single-producer/single-consumer ring of timestamped samples
+ *
+ * Author: Ahmed Surror
+ *
+ *******************************************************************************/
+
+#include "sample_ring.h"
+
+void SAMPLE_ringInit(SAMPLE_RingType *psRing)
+{
+    psRing->ui32Head = 0;
+    psRing->ui32Tail = 0;
+    psRing->ui32Dropped = 0;
+}
+
+/* Producer side, safe from an ISR. The indexes run freely and are masked on access so a
+ * full ring is told apart from an empty one without wasting a slot.
+ * When the ring is full the new sample is dropped and counted, the producer never touches
+ * the tail so it cannot overwrite the oldest sample while the consumer reads it */
+boolean SAMPLE_ringPush(SAMPLE_RingType *psRing, const SAMPLE_Type *psSample)
+{
+    uint32 ui32Head = psRing->ui32Head;
+
+    if((ui32Head - psRing->ui32Tail) >= SAMPLE_RING_SIZE)
+    {
+        psRing->ui32Dropped++;
+        return FALSE;
+    }
+
+    psRing->psSamples[ui32Head & SAMPLE_RING_MASK] = *psSample;
+    SAMPLE_RING_BARRIER();      /* The sample must be visible before the new head */
+    psRing->ui32Head = ui32Head + 1;
+    return TRUE;
+}
+
+/* Consumer side, copies up to ui32MaxSamples oldest samples and returns how many were read */
+uint32 SAMPLE_ringPopBatch(SAMPLE_RingType *psRing, SAMPLE_Type *psSamples, uint32 ui32MaxSamples)
+{
+    uint32 ui32Tail = psRing->ui32Tail;
+    uint32 ui32Available = psRing->ui32Head - ui32Tail;
+    uint32 ui32Count;
+
+    SAMPLE_RING_BARRIER();      /* Read the samples only after the head that published them */
+    if(ui32Available > ui32MaxSamples)
+    {
+        ui32Available = ui32MaxSamples;
+    }
+    for(ui32Count = 0; ui32Count < ui32Available; ui32Count++)
+    {
+        psSamples[ui32Count] = psRing->psSamples[(ui32Tail + ui32Count) & SAMPLE_RING_MASK];
+    }
+    SAMPLE_RING_BARRIER();      /* The slots must be read before they are handed back */
+    psRing->ui32Tail = ui32Tail + ui32Available;
+    return ui32Available;
+}
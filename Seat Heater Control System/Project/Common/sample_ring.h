@@ -0,0 +1,49 @@
+ /******************************************************************************
+ *
+ * Module: Common - Sample Ring
+ *
+ * File Name: sample_ring.h
+ *
+ * Description: Wait-free single-producer/single-consumer ring of timestamped samples
+ *
+ * Author: Ahmed Surror
+ *
+ *******************************************************************************/
+
+#ifndef SAMPLE_RING_H_
+#define SAMPLE_RING_H_
+
+#include "std_types.h"
+
+/* Number of samples held by a ring, must be a power of 2 */
+#define SAMPLE_RING_SIZE        16
+#define SAMPLE_RING_MASK        (SAMPLE_RING_SIZE - 1)
+
+/* The producer only ever writes the head and the consumer only ever writes the tail, so
+ * aligned 32-bit loads and stores are enough and neither side needs LDREX/STREX or a
+ * critical section. The barrier orders the sample copy against the index publication */
+#if defined(__TI_ARM__) || defined(__arm__)
+#define SAMPLE_RING_BARRIER()   __asm("    dmb")
+#else
+#define SAMPLE_RING_BARRIER()   __sync_synchronize()
+#endif
+
+typedef struct {
+    uint32 ui32Timestamp;       /* GPTM_WTimer1Read() ticks */
+    sint16 i16TempQ8;           /* Filtered temperature in Q8 C */
+    uint8 ui8Channel;
+    uint8 ui8Faults;            /* POTS_DIAG_* bits of the channel */
+} SAMPLE_Type;
+
+typedef struct {
+    volatile uint32 ui32Head;       /* Written by the producer only */
+    volatile uint32 ui32Tail;       /* Written by the consumer only */
+    volatile uint32 ui32Dropped;    /* Samples lost because the ring was full */
+    SAMPLE_Type psSamples[SAMPLE_RING_SIZE];
+} SAMPLE_RingType;
+
+void SAMPLE_ringInit(SAMPLE_RingType *psRing);
+boolean SAMPLE_ringPush(SAMPLE_RingType *psRing, const SAMPLE_Type *psSample);
+uint32 SAMPLE_ringPopBatch(SAMPLE_RingType *psRing, SAMPLE_Type *psSamples, uint32 ui32MaxSamples);
+
+#endif /* SAMPLE_RING_H_ */
@@ -64,7 +64,7 @@
  * or heap_4.c are included in the build. This value is defaulted to 4096 bytes but
  * it must be tailored to each application. Note the heap will appear in the .bss
  * section. */
-#define configTOTAL_HEAP_SIZE                 ((size_t)(4096))
+#define configTOTAL_HEAP_SIZE                 ((size_t)(8192))
 /******************************************************************************/
 /* Definitions that include or exclude functionality. *************************/
 /******************************************************************************/
@@ -81,8 +81,18 @@
 #define INCLUDE_uxTaskPriorityGet              1
 #define INCLUDE_vTaskDelayUntil                1
 #define INCLUDE_vTaskDelete                    1
+#define INCLUDE_xTaskGetCurrentTaskHandle      1
 #define configUSE_MUTEXES                      1
 
+/* Software timers are needed by the timer daemon task that runs the deferred
+ * xEventGroupSetBitsFromISR() calls made by the drivers */
+#define configUSE_TIMERS                       1
+#define configTIMER_TASK_PRIORITY              (configMAX_PRIORITIES - 1)
+#define configTIMER_QUEUE_LENGTH               10
+#define configTIMER_TASK_STACK_DEPTH           configMINIMAL_STACK_SIZE
+#define INCLUDE_xTimerPendFunctionCall         1
+#define INCLUDE_xEventGroupSetBitFromISR       1
+
 
 
 
@@ -0,0 +1,132 @@
+/*
+ * heater.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include <HAL/HEATER/heater.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_pwm.h"
+#include "inc/hw_types.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+
+/* The generators count down from LOAD = HEATER_PWM_PERIOD - 1 to 0, position t of the
+ * period (0 .. LOAD) is reached when the counter equals LOAD - t */
+#define HEATER_PWM_LOAD             (HEATER_PWM_PERIOD - 1U)
+
+/* Compare, load and generator action updates are globally synchronized: they are only
+ * latched at the end of a period after PWMSyncUpdate(), so a new duty never produces a
+ * truncated or doubled pulse */
+#define HEATER_PWM_GEN_CONFIG       (PWM_GEN_MODE_DOWN | PWM_GEN_MODE_SYNC | PWM_GEN_MODE_GEN_SYNC_GLOBAL | \
+                                     PWM_GEN_MODE_DBG_STOP)
+
+typedef struct {
+    uint32_t ui32Gen;
+    uint32_t ui32GenBit;
+    uint32_t ui32OutBit;
+    uint32_t ui32PinConfig;
+    uint8_t ui8Pin;
+}HEATER_OutputType;
+
+static const HEATER_OutputType psHeaterOutputs[HEATER_NUM_OUTPUTS] = {
+    { PWM_GEN_0, PWM_GEN_0_BIT, PWM_OUT_0_BIT, GPIO_PB6_M0PWM0, GPIO_PIN_6 },
+    { PWM_GEN_1, PWM_GEN_1_BIT, PWM_OUT_2_BIT, GPIO_PB4_M0PWM2, GPIO_PIN_4 },
+};
+
+static uint16_t pui16HeaterDuty[HEATER_NUM_OUTPUTS];
+
+void HEATER_init(void){
+
+    uint8_t ui8Output;
+    uint32_t ui32GenBits = 0;
+    uint32_t ui32OutBits = 0;
+
+    SysCtlPWMClockSet(SYSCTL_PWMDIV_64);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_PWM0)){}
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOB)){}
+
+    for(ui8Output = 0; ui8Output < HEATER_NUM_OUTPUTS; ui8Output++){
+        const HEATER_OutputType *psOutput = &psHeaterOutputs[ui8Output];
+
+        GPIOPinConfigure(psOutput->ui32PinConfig);
+        GPIOPinTypePWM(GPIO_PORTB_BASE, psOutput->ui8Pin);
+
+        PWMGenConfigure(PWM0_BASE, psOutput->ui32Gen, HEATER_PWM_GEN_CONFIG);
+        PWMGenPeriodSet(PWM0_BASE, psOutput->ui32Gen, HEATER_PWM_PERIOD);
+        HEATER_setDuty(ui8Output, 0);
+
+        ui32GenBits |= psOutput->ui32GenBit;
+        ui32OutBits |= psOutput->ui32OutBit;
+    }
+
+    /* Start all the generators together, the stagger then only depends on the compare values */
+    PWMSyncUpdate(PWM0_BASE, ui32GenBits);
+    for(ui8Output = 0; ui8Output < HEATER_NUM_OUTPUTS; ui8Output++){
+        PWMGenEnable(PWM0_BASE, psHeaterOutputs[ui8Output].ui32Gen);
+    }
+    PWMSyncTimeBase(PWM0_BASE, ui32GenBits);
+    PWMOutputState(PWM0_BASE, ui32OutBits, true);
+}
+
+/* Heater on with the default stagger of the output */
+void HEATER_setDuty(uint8_t ui8Output, uint16_t ui16DutyQ15){
+    HEATER_setPulse(ui8Output, ui16DutyQ15, (uint16_t)((ui8Output << HEATER_DUTY_FRAC_BITS) / HEATER_NUM_OUTPUTS));
+}
+
+/* Heater on from ui16PhaseQ15 of the period for ui16DutyQ15 of the period, wrapping around the
+ * end of the period. Only registers are written and the hardware applies the new pulse from
+ * the next period on, no task has to run at the PWM rate. An output must not be updated twice
+ * within one PWM period, the seat control engine runs far slower than HEATER_PWM_FREQUENCY_HZ */
+void HEATER_setPulse(uint8_t ui8Output, uint16_t ui16DutyQ15, uint16_t ui16PhaseQ15){
+
+    uint32_t ui32GenBase = PWM0_BASE + psHeaterOutputs[ui8Output].ui32Gen;
+    uint32_t ui32Phase = ((uint32_t)(ui16PhaseQ15 & HEATER_DUTY_MAX) * HEATER_PWM_PERIOD) >> HEATER_DUTY_FRAC_BITS;
+    uint32_t ui32Width = ((uint32_t)ui16DutyQ15 * HEATER_PWM_PERIOD) >> HEATER_DUTY_FRAC_BITS;
+    uint32_t ui32End = ui32Phase + ui32Width;
+    uint32_t ui32Actions;
+
+    if(ui32Width == 0){
+        ui32Actions = PWM_X_GENA_ACTLOAD_ZERO;
+    }
+    else if(ui16DutyQ15 >= HEATER_DUTY_MAX){
+        ui32Actions = PWM_X_GENA_ACTLOAD_ONE;
+    }
+    else if(ui32Phase == 0){
+        /* Pulse starts with the period */
+        ui32Actions = PWM_X_GENA_ACTLOAD_ONE | PWM_X_GENA_ACTCMPBD_ZERO;
+        HWREG(ui32GenBase + PWM_O_X_CMPB) = HEATER_PWM_LOAD - ui32End;
+    }
+    else if(ui32End < HEATER_PWM_PERIOD){
+        /* Pulse inside the period */
+        ui32Actions = PWM_X_GENA_ACTLOAD_ZERO | PWM_X_GENA_ACTCMPAD_ONE | PWM_X_GENA_ACTCMPBD_ZERO;
+        HWREG(ui32GenBase + PWM_O_X_CMPA) = HEATER_PWM_LOAD - ui32Phase;
+        HWREG(ui32GenBase + PWM_O_X_CMPB) = HEATER_PWM_LOAD - ui32End;
+    }
+    else{
+        /* Pulse wraps around the end of the period: the period starts high, falls at the
+         * wrapped end and rises again at the phase */
+        ui32End -= HEATER_PWM_PERIOD;
+        ui32Actions = PWM_X_GENA_ACTCMPAD_ONE |
+                      ((ui32End == 0) ? PWM_X_GENA_ACTLOAD_ZERO : (PWM_X_GENA_ACTLOAD_ONE | PWM_X_GENA_ACTCMPBD_ZERO));
+        HWREG(ui32GenBase + PWM_O_X_CMPA) = HEATER_PWM_LOAD - ui32Phase;
+        HWREG(ui32GenBase + PWM_O_X_CMPB) = HEATER_PWM_LOAD - ui32End;
+    }
+    HWREG(ui32GenBase + PWM_O_X_GENA) = ui32Actions;
+
+    /* Latch compare values and actions together at the end of the current period */
+    PWMSyncUpdate(PWM0_BASE, psHeaterOutputs[ui8Output].ui32GenBit);
+
+    pui16HeaterDuty[ui8Output] = ui16DutyQ15;
+}
+
+uint16_t HEATER_getDuty(uint8_t ui8Output){
+    return pui16HeaterDuty[ui8Output];
+}
@@ -0,0 +1,34 @@
+/*
+ * heater.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef HAL_HEATER_HEATER_H_
+#define HAL_HEATER_HEATER_H_
+
+#include <stdint.h>
+
+/* One PWM0 generator per heater, output A of the generator drives the heater switch */
+#define HEATER_SEAT1_OUTPUT         0      /* PB6 --> M0PWM0 (generator 0) */
+#define HEATER_SEAT2_OUTPUT         1      /* PB4 --> M0PWM2 (generator 1) */
+#define HEATER_NUM_OUTPUTS          2
+
+/* PWM clock is the 16 MHz system clock divided by 64, HEATER_PWM_PERIOD counts per period.
+ * HEATER_setDuty() staggers the outputs by HEATER_PWM_PERIOD / HEATER_NUM_OUTPUTS so no two
+ * heaters ever switch on at the same instant, HEATER_setPulse() takes the phase from the caller */
+#define HEATER_PWM_CLOCK_HZ         (16000000U / 64U)
+#define HEATER_PWM_FREQUENCY_HZ     200U
+#define HEATER_PWM_PERIOD           (HEATER_PWM_CLOCK_HZ / HEATER_PWM_FREQUENCY_HZ)
+
+/* Duty cycles are Q15, HEATER_DUTY_MAX keeps the heater permanently on */
+#define HEATER_DUTY_FRAC_BITS       15
+#define HEATER_DUTY_MAX             ((1U << HEATER_DUTY_FRAC_BITS) - 1U)
+
+void HEATER_init(void);
+void HEATER_setDuty(uint8_t ui8Output, uint16_t ui16DutyQ15);
+void HEATER_setPulse(uint8_t ui8Output, uint16_t ui16DutyQ15, uint16_t ui16PhaseQ15);
+uint16_t HEATER_getDuty(uint8_t ui8Output);
+
+#endif /* HAL_HEATER_HEATER_H_ */
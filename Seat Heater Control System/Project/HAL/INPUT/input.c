@@ -0,0 +1,155 @@
+/*
+ * input.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include <HAL/INPUT/input.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "task.h"
+#include "timers.h"
+#include "GPTM.h"
+#include "gpio.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "drivers/buttons.h"
+
+typedef struct {
+    uint32 ui32Port;
+    uint8 ui8Pin;
+    uint8 ui8Button;            /* bit of the button in ButtonsPoll() */
+}INPUT_PinType;
+
+static const INPUT_PinType psInputPins[INPUT_COUNT] = {
+    { GPIO_PORTF_BASE,      GPIO_PIN_4, LEFT_BUTTON },      /* INPUT_SW1 */
+    { GPIO_PORTF_BASE,      GPIO_PIN_0, RIGHT_BUTTON },     /* INPUT_SW2 */
+    { EXT_BUTTON_GPIO_BASE, EXT_BUTTON, EXTERNAL_BUTTON },  /* INPUT_EXT */
+};
+
+static QueueHandle_t xInputEventQueue = NULL;
+static TimerHandle_t xInputPollTimer = NULL;
+
+/* Debounced state, ButtonsPoll() bits, only written by the poll timer */
+static volatile uint8 ui8InputPressed = 0;
+
+static void INPUT_maskEdges(void)
+{
+    uint8 ui8Button;
+
+    for(ui8Button = 0; ui8Button < INPUT_COUNT; ui8Button++){
+        GPIOIntDisable(psInputPins[ui8Button].ui32Port, psInputPins[ui8Button].ui8Pin);
+    }
+}
+
+/* Settled: clear the edges latched while polling and unmask, or keep polling when a button
+ * differs from its debounced state or an edge latched meanwhile, its edge may have been
+ * cleared with the bounces. Done with the button interrupts masked: an edge can no longer
+ * start the timer between the check and the stop, an edge after it queues its start after
+ * the stop, and the GPIOIM read-modify-writes do not interleave with those of the ISR */
+static void INPUT_resumeEdges(TimerHandle_t xTimer, uint8 ui8Pressed)
+{
+    boolean bLatched = FALSE;
+    uint8 ui8Raw = 0;
+    uint8 ui8Button;
+
+    taskENTER_CRITICAL();
+    for(ui8Button = 0; ui8Button < INPUT_COUNT; ui8Button++){
+        GPIOIntClear(psInputPins[ui8Button].ui32Port, psInputPins[ui8Button].ui8Pin);
+        GPIOIntEnable(psInputPins[ui8Button].ui32Port, psInputPins[ui8Button].ui8Pin);
+    }
+    for(ui8Button = 0; ui8Button < INPUT_COUNT; ui8Button++){
+        if(GPIOPinRead(psInputPins[ui8Button].ui32Port, psInputPins[ui8Button].ui8Pin) == 0){
+            ui8Raw |= psInputPins[ui8Button].ui8Button;
+        }
+        if(GPIOIntStatus(psInputPins[ui8Button].ui32Port, false) & psInputPins[ui8Button].ui8Pin){
+            bLatched = TRUE;
+        }
+    }
+    if((ui8Raw != ui8Pressed) || bLatched){
+        INPUT_maskEdges();
+    }else{
+        xTimerStop(xTimer, 0);
+    }
+    taskEXIT_CRITICAL();
+}
+
+/* Timer service task: one step of the vertical counter for every button */
+static void INPUT_pollCallback(TimerHandle_t xTimer)
+{
+    uint32 ui32Now = GPTM_WTimer1Read();
+    uint8 ui8Delta;
+    uint8 ui8Raw;
+    uint8 ui8Pressed = ButtonsPoll(&ui8Delta, &ui8Raw);
+    INPUT_EventType sEvent;
+    uint8 ui8Button;
+
+    ui8InputPressed = ui8Pressed;
+    for(ui8Button = 0; ui8Button < INPUT_COUNT; ui8Button++){
+        if(ui8Delta & psInputPins[ui8Button].ui8Button){
+            sEvent.ui32Timestamp = ui32Now;
+            sEvent.ui8Button = ui8Button;
+            sEvent.bPressed = (ui8Pressed & psInputPins[ui8Button].ui8Button) ? TRUE : FALSE;
+            xQueueSend(xInputEventQueue, &sEvent, 0);
+        }
+    }
+
+    /* Settled: back to interrupts, nothing runs until the next edge */
+    if(ui8Raw == ui8Pressed){
+        INPUT_resumeEdges(xTimer, ui8Pressed);
+    }
+}
+
+void INPUT_init(QueueHandle_t xEventQueue)
+{
+    xInputEventQueue = xEventQueue;
+    xInputPollTimer = xTimerCreate("Input Poll", pdMS_TO_TICKS(INPUT_POLL_PERIOD_MS), pdTRUE, NULL,
+                                   INPUT_pollCallback);
+
+    /* Seeds the debounced state with the current levels */
+    ButtonsInit();
+    ui8InputPressed = ButtonsPoll(NULL, NULL);
+
+    GPIO_SW1EdgeTriggeredInterruptInit();
+    GPIO_SW2EdgeTriggeredInterruptInit();
+    GPIO_EXTSWEdgeTriggeredInterruptInit();
+}
+
+/* Debounced state of every button, INPUT_MASK() bits */
+uint32 INPUT_getPressedMask(void)
+{
+    uint8 ui8Pressed = ui8InputPressed;
+    uint32 ui32Mask = 0;
+    uint8 ui8Button;
+
+    for(ui8Button = 0; ui8Button < INPUT_COUNT; ui8Button++){
+        if(ui8Pressed & psInputPins[ui8Button].ui8Button){
+            ui32Mask |= INPUT_MASK(ui8Button);
+        }
+    }
+    return ui32Mask;
+}
+
+/* First edge of a burst: mask every button and let the poll timer take over */
+static void INPUT_portHandler(uint32 ui32Port)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    GPIOIntClear(ui32Port, GPIOIntStatus(ui32Port, TRUE));
+    INPUT_maskEdges();
+    xTimerStartFromISR(xInputPollTimer, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* GPIO port F interrupt: SW1 and SW2 */
+void INPUT_GPIOPortFHandler(void)
+{
+    INPUT_portHandler(GPIO_PORTF_BASE);
+}
+
+/* GPIO port B interrupt: external button */
+void INPUT_GPIOPortBHandler(void)
+{
+    INPUT_portHandler(GPIO_PORTB_BASE);
+}
@@ -0,0 +1,46 @@
+/*
+ * input.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef HAL_INPUT_INPUT_H_
+#define HAL_INPUT_INPUT_H_
+
+#include "std_types.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/* Level buttons, all active low with pull-ups */
+#define INPUT_SW1               0       /* PF4 */
+#define INPUT_SW2               1       /* PF0 */
+#define INPUT_EXT               2       /* PB0 */
+#define INPUT_COUNT             3
+
+#define INPUT_MASK(button)      (1U << (button))
+
+/* Both edges of every button interrupt. The ISR masks the button interrupts and starts a
+ * software timer which runs ButtonsPoll() of drivers/buttons.c every INPUT_POLL_PERIOD_MS:
+ * its vertical counter takes a new level after four equal polls, 30 to 40 ms. Presses and
+ * releases are queued as INPUT_EventType for the input task, and once every button reads
+ * its debounced level the timer stops and the interrupts are unmasked again */
+#define INPUT_POLL_PERIOD_MS    (10U)
+
+/* One press and one release of every button between two reads of the input task */
+#define INPUT_QUEUE_LENGTH      (2U * INPUT_COUNT)
+
+/* Debounced press / release queued by the poll timer */
+typedef struct {
+    uint32 ui32Timestamp;       /* GPTM_WTimer1Read() ticks of the poll that took it */
+    uint8 ui8Button;            /* INPUT_SW1 .. INPUT_EXT */
+    boolean bPressed;
+}INPUT_EventType;
+
+void INPUT_init(QueueHandle_t xEventQueue);
+uint32 INPUT_getPressedMask(void);
+
+void INPUT_GPIOPortFHandler(void);
+void INPUT_GPIOPortBHandler(void);
+
+#endif /* HAL_INPUT_INPUT_H_ */
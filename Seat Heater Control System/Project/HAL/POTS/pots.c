@@ -6,59 +6,365 @@
  */
 
 #include <HAL/POTS/pots.h>
+#include <HAL/POTS/pots_filter.h>
+#include <HAL/POTS/pots_diag.h>
+#include <HAL/POTS/pots_lut.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
 #include "uart0.h"
+#include "GPTM.h"
+#include "inc/hw_adc.h"
+#include "inc/hw_ints.h"
 #include "inc/hw_memmap.h"
 #include "driverlib/adc.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/udma.h"
 #include "MCAL/GPIO/gpio.h"
 
-void POT1_init(void){
+/* Sample sequencer 1 has a 4-entry FIFO, enough to convert both seats in one trigger */
+#define POTS_SEQUENCER       1
+
+/* Sample sequencer 0 is dedicated to the timer triggered uDMA stream */
+#define POTS_STREAM_SEQUENCER    0
+#define POTS_STREAM_BUFFER_SIZE  (POTS_STREAM_BLOCK_SIZE * POTS_NUM_CHANNELS)
+
+/* Every channel is watched by three digital comparators fed by extra steps of the stream
+ * sequence: one interrupts on entering the low band, one on entering the high band and
+ * one on coming back to the mid band. SS0 has 8 steps: 2 FIFO steps + 3 x 2 comparator steps */
+#define POTS_COMP_PER_CHANNEL    3
+#define POTS_COMP_LOW(ch)        ((ch) * POTS_COMP_PER_CHANNEL)
+#define POTS_COMP_HIGH(ch)       ((ch) * POTS_COMP_PER_CHANNEL + 1)
+#define POTS_COMP_MID(ch)        ((ch) * POTS_COMP_PER_CHANNEL + 2)
+#define POTS_CTL_CMP(comp)       (ADC_CTL_CMP0 + ((uint32_t)(comp) << 16))
+
+#if (POTS_DIAG_SAMPLE_RATE_HZ != POTS_STREAM_SAMPLE_RATE_HZ)
+#error "POTS_DIAG_SAMPLE_RATE_HZ must match POTS_STREAM_SAMPLE_RATE_HZ"
+#endif
+
+/* ADC0 SS0 calls FreeRTOS FromISR APIs so it must not be above the max syscall priority */
+#define POTS_INTERRUPT_PRIORITY  (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
+
+/* Ping-pong buffers filled by the uDMA primary and alternate control structures.
+ * Samples are interleaved: seat 1, seat 2, seat 1, seat 2, ... */
+static uint16_t pui16StreamPingBuffer[POTS_STREAM_BUFFER_SIZE];
+static uint16_t pui16StreamPongBuffer[POTS_STREAM_BUFFER_SIZE];
+
+/* Latest filtered value of every channel, updated once per completed block */
+static volatile uint32_t pui32LatestValue[POTS_NUM_CHANNELS];
+
+/* Median and IIR state of every channel */
+static POTS_FilterStateType psFilterState[POTS_NUM_CHANNELS];
+
+/* ADC input of every channel */
+static const uint32_t pui32ChannelCtl[POTS_NUM_CHANNELS] = {ADC_CTL_CH0, ADC_CTL_CH1};
+
+/* Bit per channel set while its raw samples are outside of the validity window */
+static volatile uint32_t ui32FaultMask = 0;
+
+/* Plausibility diagnosis state of every channel and the packed POTS_DIAG_* bitmap */
+static POTS_DiagStateType psDiagState[POTS_NUM_CHANNELS];
+static volatile uint32_t ui32DiagFaults = 0;
+
+/* Timestamped filtered samples of every channel, filled once per block by the stream ISR */
+static SAMPLE_RingType psSampleRing[POTS_NUM_CHANNELS];
+
+/* Temperature last announced with POTS_TEMP_EVENT() and time of the last ring push, per channel */
+static int16_t pi16AnnouncedTempQ8[POTS_NUM_CHANNELS];
+static uint32_t pui32LastPushTime[POTS_NUM_CHANNELS];
+
+/* Event group receiving POTS_RANGE_EVENT(), POTS_DIAG_EVENT() and POTS_TEMP_EVENT() bits */
+static EventGroupHandle_t xPotsEventGroup = NULL;
+
+static void POTS_streamInit(void);
+static void POTS_comparatorsInit(void);
+static void POTS_comparatorsHandler(BaseType_t *pxHigherPriorityTaskWoken);
+static void POTS_streamProcessBlock(const uint16_t *pui16Block, BaseType_t *pxHigherPriorityTaskWoken);
+
+void POTS_init(EventGroupHandle_t xEventGroup){
+    xPotsEventGroup = xEventGroup;
+
     SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-    GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_3);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_ADC0)){}
+    GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_3 | GPIO_PIN_2);
+
+#if (POTS_FILTER_HW_OVERSAMPLE > 1)
+    /* First filter stage: every sample is the average of several conversions done by the ADC */
+    ADCHardwareOversampleConfigure(ADC0_BASE, POTS_FILTER_HW_OVERSAMPLE);
+#endif
+
+    /* SS1 only takes the seed conversion: step 0 samples seat 1, step 1 samples seat 2 and ends it */
+    ADCSequenceDisable(ADC0_BASE, POTS_SEQUENCER);
+    ADCSequenceConfigure(ADC0_BASE, POTS_SEQUENCER, ADC_TRIGGER_PROCESSOR, 0);
+    ADCSequenceStepConfigure(ADC0_BASE, POTS_SEQUENCER, 0, ADC_CTL_CH0);
+    ADCSequenceStepConfigure(ADC0_BASE, POTS_SEQUENCER, 1, ADC_CTL_CH1 | ADC_CTL_IE |
+                             ADC_CTL_END);
+    ADCSequenceEnable(ADC0_BASE, POTS_SEQUENCER);
+    ADCIntClear(ADC0_BASE, POTS_SEQUENCER);
 
+    /* Seed the latest values with one polled conversion so that the getters are valid
+     * before the first stream block completes */
+    ADCProcessorTrigger(ADC0_BASE, POTS_SEQUENCER);
+    while(!ADCIntStatus(ADC0_BASE, POTS_SEQUENCER, FALSE));
+    ADCIntClear(ADC0_BASE, POTS_SEQUENCER);
+    ADCSequenceDataGet(ADC0_BASE, POTS_SEQUENCER, (uint32_t *)pui32LatestValue);
+    POTS_filterInit(&psFilterState[POTS_SEAT1_CHANNEL], pui32LatestValue[POTS_SEAT1_CHANNEL]);
+    POTS_filterInit(&psFilterState[POTS_SEAT2_CHANNEL], pui32LatestValue[POTS_SEAT2_CHANNEL]);
+    POTS_diagInit(&psDiagState[POTS_SEAT1_CHANNEL], pui32LatestValue[POTS_SEAT1_CHANNEL]);
+    POTS_diagInit(&psDiagState[POTS_SEAT2_CHANNEL], pui32LatestValue[POTS_SEAT2_CHANNEL]);
+    SAMPLE_ringInit(&psSampleRing[POTS_SEAT1_CHANNEL]);
+    SAMPLE_ringInit(&psSampleRing[POTS_SEAT2_CHANNEL]);
+    pi16AnnouncedTempQ8[POTS_SEAT1_CHANNEL] = POTS_getLatestTempQ8(POTS_SEAT1_CHANNEL);
+    pi16AnnouncedTempQ8[POTS_SEAT2_CHANNEL] = POTS_getLatestTempQ8(POTS_SEAT2_CHANNEL);
+    /* Backdated so the first block already pushes a sample */
+    pui32LastPushTime[POTS_SEAT1_CHANNEL] = GPTM_WTimer1Read() - (POTS_SAMPLE_KEEPALIVE_MS * GPTM_TIMESTAMP_TICKS_PER_MS);
+    pui32LastPushTime[POTS_SEAT2_CHANNEL] = pui32LastPushTime[POTS_SEAT1_CHANNEL];
 
+    POTS_comparatorsInit();
+    POTS_streamInit();
 }
-uint32_t POT1_getValue(){
 
-    uint32_t pui32ADC0Value[1];
+/* Non-blocking getter of the latest filtered value of a channel */
+uint32_t POTS_getLatestValue(uint8_t ui8Channel){
+    return pui32LatestValue[ui8Channel];
+}
 
-    ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_PROCESSOR, 0);
-    ADCSequenceStepConfigure(ADC0_BASE, 3, 0, ADC_CTL_CH0 | ADC_CTL_IE |
-                             ADC_CTL_END);
-    ADCSequenceEnable(ADC0_BASE, 3);
-    ADCIntClear(ADC0_BASE, 3);
-
-    ADCProcessorTrigger(ADC0_BASE, 3);
-    while(!ADCIntStatus(ADC0_BASE, 3, FALSE));  // Wait for conversion to be completed.
-    ADCIntClear(ADC0_BASE, 3);
-    ADCSequenceDataGet(ADC0_BASE, 3, pui32ADC0Value);
-    return pui32ADC0Value[0];
+/* Non-blocking getter of the latest filtered value of a channel linearized to Q8 C */
+int16_t POTS_getLatestTempQ8(uint8_t ui8Channel){
+    return POTS_lutToTempQ8((uint16_t)pui32LatestValue[ui8Channel]);
 }
 
-void POT2_init(void){
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-    GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_2);
+/* Bit mask of the channels whose raw samples are outside of the validity window */
+uint32_t POTS_getFaultMask(void){
+    return ui32FaultMask;
+}
 
+/* Drain up to ui32MaxSamples of the oldest timestamped samples of a channel, returns how
+ * many were read. Every channel has its own ring so each one must have a single reader */
+uint32_t POTS_readSamples(uint8_t ui8Channel, SAMPLE_Type *psSamples, uint32_t ui32MaxSamples){
+    return SAMPLE_ringPopBatch(&psSampleRing[ui8Channel], psSamples, ui32MaxSamples);
+}
 
+/* Samples of a channel lost because its reader did not keep up */
+uint32_t POTS_getDroppedSamples(uint8_t ui8Channel){
+    return psSampleRing[ui8Channel].ui32Dropped;
 }
-uint32_t POT2_getValue(){
 
-    uint32_t pui32ADC0Value[1];
+/* Packed POTS_DIAG_* fault bits of all the channels, see POTS_DIAG_CHANNEL_FAULTS() */
+uint32_t POTS_getDiagFaults(void){
+    return ui32DiagFaults;
+}
 
-    ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_PROCESSOR, 0);
-    ADCSequenceStepConfigure(ADC0_BASE, 3, 0, ADC_CTL_CH1 | ADC_CTL_IE |
-                             ADC_CTL_END);
-    ADCSequenceEnable(ADC0_BASE, 3);
-    ADCIntClear(ADC0_BASE, 3);
-
-    ADCProcessorTrigger(ADC0_BASE, 3);
-    while(!ADCIntStatus(ADC0_BASE, 3, FALSE));  // Wait for conversion to be completed.
-    ADCIntClear(ADC0_BASE, 3);
-    ADCSequenceDataGet(ADC0_BASE, 3, pui32ADC0Value);
-    return pui32ADC0Value[0];
+/* The channel is inside its validity window and passes every plausibility check */
+bool POTS_isChannelHealthy(uint8_t ui8Channel){
+    return (!(ui32FaultMask & (1U << ui8Channel))) &&
+           (POTS_DIAG_CHANNEL_FAULTS(ui32DiagFaults, ui8Channel) == 0);
+}
+
+/* The stuck sensor check only runs while the heater of the channel is on */
+void POTS_diagSetHeating(uint8_t ui8Channel, bool bHeating){
+    psDiagState[ui8Channel].bHeating = bHeating;
+}
+
+static void POTS_comparatorsInit(void){
+    uint16_t ui16RawLow;
+    uint16_t ui16RawHigh;
+    uint8_t ui8Channel;
+
+    /* Raw codes bounding the validity window, whatever the direction of the sensor curve */
+    POTS_lutFindWindow(POTS_VALID_TEMP_MIN_C << POTS_TEMP_Q8_SHIFT,
+                       ((POTS_VALID_TEMP_MAX_C + 1) << POTS_TEMP_Q8_SHIFT) - 1,
+                       &ui16RawLow, &ui16RawHigh);
+
+    for(ui8Channel = 0; ui8Channel < POTS_NUM_CHANNELS; ui8Channel++){
+        /* Low band: raw < ui16RawLow, high band: raw > ui16RawHigh */
+        ADCComparatorConfigure(ADC0_BASE, POTS_COMP_LOW(ui8Channel), ADC_COMP_INT_LOW_ONCE);
+        ADCComparatorConfigure(ADC0_BASE, POTS_COMP_HIGH(ui8Channel), ADC_COMP_INT_HIGH_ONCE);
+        ADCComparatorConfigure(ADC0_BASE, POTS_COMP_MID(ui8Channel), ADC_COMP_INT_MID_ONCE);
+        ADCComparatorRegionSet(ADC0_BASE, POTS_COMP_LOW(ui8Channel), ui16RawLow - 1, ui16RawHigh);
+        ADCComparatorRegionSet(ADC0_BASE, POTS_COMP_HIGH(ui8Channel), ui16RawLow - 1, ui16RawHigh);
+        ADCComparatorRegionSet(ADC0_BASE, POTS_COMP_MID(ui8Channel), ui16RawLow - 1, ui16RawHigh);
+        ADCComparatorReset(ADC0_BASE, POTS_COMP_LOW(ui8Channel), TRUE, TRUE);
+        ADCComparatorReset(ADC0_BASE, POTS_COMP_HIGH(ui8Channel), TRUE, TRUE);
+        ADCComparatorReset(ADC0_BASE, POTS_COMP_MID(ui8Channel), TRUE, TRUE);
+
+        /* Initial state from the seeding conversion, the comparators report the changes */
+        if((pui32LatestValue[ui8Channel] < ui16RawLow) || (pui32LatestValue[ui8Channel] > ui16RawHigh)){
+            ui32FaultMask |= (1U << ui8Channel);
+        }
+    }
+    ADCComparatorIntClear(ADC0_BASE, 0xFF);
+}
+
+/* Digital comparator interrupts of the stream sequence, update the fault mask and
+ * signal every change to the event group right away */
+static void POTS_comparatorsHandler(BaseType_t *pxHigherPriorityTaskWoken){
+    uint32_t ui32CompStatus = ADCComparatorIntStatus(ADC0_BASE);
+    uint32_t ui32NewFaultMask = ui32FaultMask;
+    uint32_t ui32ChangedMask;
+    uint8_t ui8Channel;
+
+    ADCComparatorIntClear(ADC0_BASE, ui32CompStatus);
+
+    for(ui8Channel = 0; ui8Channel < POTS_NUM_CHANNELS; ui8Channel++){
+        /* If the channel left and re-entered the window within the interrupt latency the
+         * fault wins, the next excursion or the mid band interrupt will settle it */
+        if(ui32CompStatus & ((1U << POTS_COMP_LOW(ui8Channel)) | (1U << POTS_COMP_HIGH(ui8Channel)))){
+            ui32NewFaultMask |= (1U << ui8Channel);
+        }
+        else if(ui32CompStatus & (1U << POTS_COMP_MID(ui8Channel))){
+            ui32NewFaultMask &= ~(1U << ui8Channel);
+        }
+    }
+
+    ui32ChangedMask = ui32NewFaultMask ^ ui32FaultMask;
+    ui32FaultMask = ui32NewFaultMask;
+    if((ui32ChangedMask != 0) && (xPotsEventGroup != NULL)){
+        xEventGroupSetBitsFromISR(xPotsEventGroup, ui32ChangedMask, pxHigherPriorityTaskWoken);
+    }
+}
+
+static void POTS_streamInit(void){
+    uint8_t ui8Channel;
+    uint8_t ui8Step = 0;
+
+    /* ADC0 SS0 converts every seat into the FIFO on every Timer0A timeout and requests a
+     * uDMA burst, then converts them again into their window comparators */
+    ADCSequenceDisable(ADC0_BASE, POTS_STREAM_SEQUENCER);
+    ADCSequenceConfigure(ADC0_BASE, POTS_STREAM_SEQUENCER, ADC_TRIGGER_TIMER, 0);
+    for(ui8Channel = 0; ui8Channel < POTS_NUM_CHANNELS; ui8Channel++){
+        ADCSequenceStepConfigure(ADC0_BASE, POTS_STREAM_SEQUENCER, ui8Step++, pui32ChannelCtl[ui8Channel]);
+    }
+    for(ui8Channel = 0; ui8Channel < POTS_NUM_CHANNELS; ui8Channel++){
+        ADCSequenceStepConfigure(ADC0_BASE, POTS_STREAM_SEQUENCER, ui8Step++,
+                                 pui32ChannelCtl[ui8Channel] | POTS_CTL_CMP(POTS_COMP_LOW(ui8Channel)));
+        ADCSequenceStepConfigure(ADC0_BASE, POTS_STREAM_SEQUENCER, ui8Step++,
+                                 pui32ChannelCtl[ui8Channel] | POTS_CTL_CMP(POTS_COMP_HIGH(ui8Channel)));
+        ADCSequenceStepConfigure(ADC0_BASE, POTS_STREAM_SEQUENCER, ui8Step++,
+                                 pui32ChannelCtl[ui8Channel] | POTS_CTL_CMP(POTS_COMP_MID(ui8Channel)) |
+                                 ((ui8Channel == (POTS_NUM_CHANNELS - 1)) ? (ADC_CTL_IE | ADC_CTL_END) : 0));
+    }
+
+    /* uDMA ping-pong: primary fills the ping buffer while the CPU works on the pong one */
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_ADC0, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(UDMA_CHANNEL_ADC0 | UDMA_PRI_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_2);
+    uDMAChannelControlSet(UDMA_CHANNEL_ADC0 | UDMA_ALT_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_2);
+    uDMAChannelTransferSet(UDMA_CHANNEL_ADC0 | UDMA_PRI_SELECT, UDMA_MODE_PINGPONG,
+                           (void *)(ADC0_BASE + ADC_O_SSFIFO0), pui16StreamPingBuffer,
+                           POTS_STREAM_BUFFER_SIZE);
+    uDMAChannelTransferSet(UDMA_CHANNEL_ADC0 | UDMA_ALT_SELECT, UDMA_MODE_PINGPONG,
+                           (void *)(ADC0_BASE + ADC_O_SSFIFO0), pui16StreamPongBuffer,
+                           POTS_STREAM_BUFFER_SIZE);
+    uDMAChannelEnable(UDMA_CHANNEL_ADC0);
+
+    ADCSequenceDMAEnable(ADC0_BASE, POTS_STREAM_SEQUENCER);
+    ADCSequenceEnable(ADC0_BASE, POTS_STREAM_SEQUENCER);
+    ADCIntClearEx(ADC0_BASE, ADC_INT_DMA_SS0 | ADC_INT_DCON_SS0);
+    ADCIntEnableEx(ADC0_BASE, ADC_INT_DMA_SS0 | ADC_INT_DCON_SS0);
+    IntPrioritySet(INT_ADC0SS0, POTS_INTERRUPT_PRIORITY);
+    IntEnable(INT_ADC0SS0);
+
+    /* Timer0A periodic timeout is the ADC trigger */
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER0)){}
+    TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(TIMER0_BASE, TIMER_A, (SysCtlClockGet() / POTS_STREAM_SAMPLE_RATE_HZ) - 1);
+    TimerControlTrigger(TIMER0_BASE, TIMER_A, true);
+    TimerEnable(TIMER0_BASE, TIMER_A);
+}
+
+/* Reduce a completed block to one filtered value per channel:
+ * median on every sample, block average, then IIR at the block rate.
+ * Every sample also goes through the plausibility diagnosis. Readers are only
+ * woken up when the temperature leaves the deadband or the faults change */
+static void POTS_streamProcessBlock(const uint16_t *pui16Block, BaseType_t *pxHigherPriorityTaskWoken){
+    uint32_t pui32Sum[POTS_NUM_CHANNELS] = {0};
+    uint8_t pui8Faults[POTS_NUM_CHANNELS] = {0};
+    uint32_t ui32NewDiagFaults = 0;
+    uint32_t ui32ChangedEvents = 0;
+    uint32_t ui32Index;
+    uint16_t ui16Raw;
+    uint16_t ui16Median;
+    uint8_t ui8Channel;
+    int16_t i16Delta;
+    bool bPush;
+    SAMPLE_Type sSample;
+
+    for(ui32Index = 0; ui32Index < POTS_STREAM_BUFFER_SIZE; ui32Index += POTS_NUM_CHANNELS){
+        for(ui8Channel = 0; ui8Channel < POTS_NUM_CHANNELS; ui8Channel++){
+            ui16Raw = pui16Block[ui32Index + ui8Channel] & 0x0FFF;
+            ui16Median = POTS_filterMedian(&psFilterState[ui8Channel], ui16Raw);
+            pui32Sum[ui8Channel] += ui16Median;
+            pui8Faults[ui8Channel] = POTS_diagUpdate(&psDiagState[ui8Channel], ui16Raw, ui16Median);
+        }
+    }
+    for(ui8Channel = 0; ui8Channel < POTS_NUM_CHANNELS; ui8Channel++){
+        pui32LatestValue[ui8Channel] = POTS_filterIir(&psFilterState[ui8Channel],
+                                                      pui32Sum[ui8Channel] >> POTS_STREAM_BLOCK_SHIFT);
+        ui32NewDiagFaults |= (uint32_t)pui8Faults[ui8Channel] << (ui8Channel * POTS_DIAG_BITS_PER_CHANNEL);
+
+        sSample.ui32Timestamp = GPTM_WTimer1Read();
+        sSample.i16TempQ8 = POTS_lutToTempQ8((uint16_t)pui32LatestValue[ui8Channel]);
+        sSample.ui8Channel = ui8Channel;
+        sSample.ui8Faults = pui8Faults[ui8Channel];
+
+        i16Delta = sSample.i16TempQ8 - pi16AnnouncedTempQ8[ui8Channel];
+        bPush = (sSample.ui32Timestamp - pui32LastPushTime[ui8Channel]) >=
+                (POTS_SAMPLE_KEEPALIVE_MS * GPTM_TIMESTAMP_TICKS_PER_MS);
+
+        if((i16Delta >= POTS_TEMP_EVENT_DEADBAND_Q8) || (i16Delta <= -POTS_TEMP_EVENT_DEADBAND_Q8)){
+            pi16AnnouncedTempQ8[ui8Channel] = sSample.i16TempQ8;
+            ui32ChangedEvents |= POTS_TEMP_EVENT(ui8Channel);
+            bPush = true;
+        }
+        if(POTS_DIAG_CHANNEL_FAULTS(ui32NewDiagFaults ^ ui32DiagFaults, ui8Channel) != 0){
+            ui32ChangedEvents |= POTS_DIAG_EVENT(ui8Channel);
+            bPush = true;
+        }
+        if(bPush){
+            SAMPLE_ringPush(&psSampleRing[ui8Channel], &sSample);
+            pui32LastPushTime[ui8Channel] = sSample.ui32Timestamp;
+        }
+    }
+
+    ui32DiagFaults = ui32NewDiagFaults;
+    if((ui32ChangedEvents != 0) && (xPotsEventGroup != NULL)){
+        xEventGroupSetBitsFromISR(xPotsEventGroup, ui32ChangedEvents, pxHigherPriorityTaskWoken);
+    }
+}
+
+/* ADC0 sample sequencer 0 interrupt: uDMA transfer complete, fires once per block,
+ * or digital comparator, fires once per validity window crossing */
+void POTS_ADC0Seq0Handler(void){
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t ui32Status = ADCIntStatusEx(ADC0_BASE, TRUE);
+
+    ADCIntClearEx(ADC0_BASE, ui32Status);
+
+    if(ui32Status & ADC_INT_DCON_SS0){
+        POTS_comparatorsHandler(&xHigherPriorityTaskWoken);
+    }
+
+    if(uDMAChannelModeGet(UDMA_CHANNEL_ADC0 | UDMA_PRI_SELECT) == UDMA_MODE_STOP){
+        POTS_streamProcessBlock(pui16StreamPingBuffer, &xHigherPriorityTaskWoken);
+        uDMAChannelTransferSet(UDMA_CHANNEL_ADC0 | UDMA_PRI_SELECT, UDMA_MODE_PINGPONG,
+                               (void *)(ADC0_BASE + ADC_O_SSFIFO0), pui16StreamPingBuffer,
+                               POTS_STREAM_BUFFER_SIZE);
+    }
+    if(uDMAChannelModeGet(UDMA_CHANNEL_ADC0 | UDMA_ALT_SELECT) == UDMA_MODE_STOP){
+        POTS_streamProcessBlock(pui16StreamPongBuffer, &xHigherPriorityTaskWoken);
+        uDMAChannelTransferSet(UDMA_CHANNEL_ADC0 | UDMA_ALT_SELECT, UDMA_MODE_PINGPONG,
+                               (void *)(ADC0_BASE + ADC_O_SSFIFO0), pui16StreamPongBuffer,
+                               POTS_STREAM_BUFFER_SIZE);
+    }
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
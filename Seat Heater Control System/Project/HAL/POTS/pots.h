@@ -9,15 +9,61 @@
 #define HAL_POTS_POTS_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "event_groups.h"
+#include "sample_ring.h"
 
-#define POT1_MAX_VALUE   4096
-#define POT2_MAX_VALUE   4096
+#define POTS_MAX_VALUE       4096
 
-void POT1_init(void);
-uint32_t POT1_getValue();
+/* Channel index of each seat sensor, as passed to POTS_getLatestValue() and the other getters */
+#define POTS_SEAT1_CHANNEL   0      /* PE3 --> AIN0 */
+#define POTS_SEAT2_CHANNEL   1      /* PE2 --> AIN1 */
+#define POTS_NUM_CHANNELS    2
 
-void POT2_init(void);
-uint32_t POT2_getValue();
+/* Continuous acquisition: Timer0A triggers ADC0 SS0 at POTS_STREAM_SAMPLE_RATE_HZ and
+ * uDMA moves the results into ping-pong buffers of POTS_STREAM_BLOCK_SIZE samples per
+ * channel, so the CPU is only interrupted once per completed block.
+ * POTS_STREAM_BLOCK_SIZE must be a power of 2 */
+#define POTS_STREAM_SAMPLE_RATE_HZ   1000
+#define POTS_STREAM_BLOCK_SIZE       32
+#define POTS_STREAM_BLOCK_SHIFT      5
+
+/* Validity window of the seat sensors, watched by the ADC digital comparators */
+#define POTS_VALID_TEMP_MIN_C        5
+#define POTS_VALID_TEMP_MAX_C        40
+
+/* Event group bit set each time a channel enters or leaves the validity window,
+ * the current state is given by POTS_getFaultMask() */
+#define POTS_RANGE_EVENT(ch)         (1U << (ch))
+#define POTS_RANGE_EVENTS_ALL        ((1U << POTS_NUM_CHANNELS) - 1U)
+
+/* Event group bit set each time the plausibility faults of a channel change,
+ * the current state is given by POTS_getDiagFaults() */
+#define POTS_DIAG_EVENT(ch)          (1U << (POTS_NUM_CHANNELS + (ch)))
+
+/* Event group bit set when the filtered temperature of a channel moves at least
+ * POTS_TEMP_EVENT_DEADBAND_Q8 away from the last one announced. Samples are only pushed
+ * into the ring of a channel on such a change, or POTS_SAMPLE_KEEPALIVE_MS after the previous
+ * push so the reader can still tell a steady sensor from a stalled stream */
+#define POTS_TEMP_EVENT(ch)          (1U << ((2 * POTS_NUM_CHANNELS) + (ch)))
+#define POTS_TEMP_EVENT_DEADBAND_Q8  128        /* 0.5 C */
+#define POTS_SAMPLE_KEEPALIVE_MS     1000
+
+/* Event group bits used by the POTS driver, the application may use the next ones */
+#define POTS_EVENT_BITS              (3 * POTS_NUM_CHANNELS)
+
+void POTS_init(EventGroupHandle_t xEventGroup);
+uint32_t POTS_getLatestValue(uint8_t ui8Channel);
+int16_t POTS_getLatestTempQ8(uint8_t ui8Channel);
+uint32_t POTS_readSamples(uint8_t ui8Channel, SAMPLE_Type *psSamples, uint32_t ui32MaxSamples);
+uint32_t POTS_getDroppedSamples(uint8_t ui8Channel);
+uint32_t POTS_getFaultMask(void);
+uint32_t POTS_getDiagFaults(void);
+bool POTS_isChannelHealthy(uint8_t ui8Channel);
+void POTS_diagSetHeating(uint8_t ui8Channel, bool bHeating);
+
+void POTS_ADC0Seq0Handler(void);
 
 
 #endif /* HAL_POTS_POTS_H_ */
@@ -0,0 +1,100 @@
+/*
+ * pots_diag.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include <HAL/POTS/pots_diag.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define POTS_DIAG_STUCK_SAMPLES   POTS_DIAG_MS_TO_SAMPLES(POTS_DIAG_STUCK_TIME_MS)
+#define POTS_DIAG_RATE_SAMPLES    POTS_DIAG_MS_TO_SAMPLES(POTS_DIAG_RATE_INTERVAL_MS)
+
+/* Debounce one check: the fault is set after ui16Debounce consecutive bad results and
+ * cleared after ui16Heal consecutive good ones */
+static void POTS_diagCheck(POTS_DiagStateType *psDiag, POTS_DiagCheckType eCheck, bool bBad,
+                           uint16_t ui16Debounce, uint16_t ui16Heal){
+    POTS_DiagCounterType *psCounter = &psDiag->psCounter[eCheck];
+    uint8_t ui8Bit = (uint8_t)(1U << eCheck);
+
+    if(bBad){
+        psCounter->ui16Heal = 0;
+        if((!(psDiag->ui8Faults & ui8Bit)) && (++psCounter->ui16Debounce >= ui16Debounce)){
+            psDiag->ui8Faults |= ui8Bit;
+        }
+    }
+    else{
+        psCounter->ui16Debounce = 0;
+        if((psDiag->ui8Faults & ui8Bit) && (++psCounter->ui16Heal >= ui16Heal)){
+            psDiag->ui8Faults &= ~ui8Bit;
+            psCounter->ui16Heal = 0;
+        }
+    }
+}
+
+void POTS_diagInit(POTS_DiagStateType *psDiag, uint16_t ui16InitialValue){
+    uint8_t ui8Check;
+
+    for(ui8Check = 0; ui8Check < POTS_DIAG_NUM_CHECKS; ui8Check++){
+        psDiag->psCounter[ui8Check].ui16Debounce = 0;
+        psDiag->psCounter[ui8Check].ui16Heal = 0;
+    }
+    psDiag->ui8Faults = 0;
+    psDiag->bHeating = false;
+    psDiag->ui16StuckMin = ui16InitialValue;
+    psDiag->ui16StuckMax = ui16InitialValue;
+    psDiag->ui32StuckSamples = 0;
+    psDiag->ui16RateReference = ui16InitialValue;
+    psDiag->ui16RateSamples = 0;
+}
+
+/* Run every check on one sample, ui16Raw is the unfiltered sample and ui16Median the
+ * output of the median stage. Returns the POTS_DIAG_* fault bits of the channel.
+ * A handful of compares and increments per call so it keeps up with the sample rate */
+uint8_t POTS_diagUpdate(POTS_DiagStateType *psDiag, uint16_t ui16Raw, uint16_t ui16Median){
+    uint16_t ui16RateDelta;
+
+    POTS_diagCheck(psDiag, POTS_DIAG_CHECK_OPEN, ui16Raw >= POTS_DIAG_OPEN_RAW,
+                   POTS_DIAG_OPEN_SHORT_DEBOUNCE, POTS_DIAG_OPEN_SHORT_HEAL);
+    POTS_diagCheck(psDiag, POTS_DIAG_CHECK_SHORT, ui16Raw <= POTS_DIAG_SHORT_RAW,
+                   POTS_DIAG_OPEN_SHORT_DEBOUNCE, POTS_DIAG_OPEN_SHORT_HEAL);
+
+    /* Stuck: track the raw span over a window, only meaningful while the heater is on. Once
+     * set it is also tracked with the heater off: the seat turns its heater off on the fault
+     * and a live input still shows its noise, so the fault can heal */
+    if(psDiag->bHeating || (psDiag->ui8Faults & POTS_DIAG_STUCK)){
+        if(ui16Raw < psDiag->ui16StuckMin){
+            psDiag->ui16StuckMin = ui16Raw;
+        }
+        if(ui16Raw > psDiag->ui16StuckMax){
+            psDiag->ui16StuckMax = ui16Raw;
+        }
+        if(++psDiag->ui32StuckSamples >= POTS_DIAG_STUCK_SAMPLES){
+            POTS_diagCheck(psDiag, POTS_DIAG_CHECK_STUCK,
+                           (psDiag->ui16StuckMax - psDiag->ui16StuckMin) <= POTS_DIAG_STUCK_BAND_RAW,
+                           POTS_DIAG_STUCK_DEBOUNCE, POTS_DIAG_STUCK_HEAL);
+            psDiag->ui32StuckSamples = 0;
+            psDiag->ui16StuckMin = ui16Raw;
+            psDiag->ui16StuckMax = ui16Raw;
+        }
+    }
+    else{
+        psDiag->ui32StuckSamples = 0;
+        psDiag->ui16StuckMin = ui16Raw;
+        psDiag->ui16StuckMax = ui16Raw;
+    }
+
+    /* Rate of change: compare the median output with the one of the previous interval */
+    if(++psDiag->ui16RateSamples >= POTS_DIAG_RATE_SAMPLES){
+        ui16RateDelta = (ui16Median > psDiag->ui16RateReference) ?
+                        (ui16Median - psDiag->ui16RateReference) : (psDiag->ui16RateReference - ui16Median);
+        POTS_diagCheck(psDiag, POTS_DIAG_CHECK_RATE, ui16RateDelta > POTS_DIAG_RATE_MAX_RAW,
+                       POTS_DIAG_RATE_DEBOUNCE, POTS_DIAG_RATE_HEAL);
+        psDiag->ui16RateReference = ui16Median;
+        psDiag->ui16RateSamples = 0;
+    }
+
+    return psDiag->ui8Faults;
+}
@@ -0,0 +1,77 @@
+/*
+ * pots_diag.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef HAL_POTS_POTS_DIAG_H_
+#define HAL_POTS_POTS_DIAG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Rate at which POTS_diagUpdate() is called, must match POTS_STREAM_SAMPLE_RATE_HZ */
+#define POTS_DIAG_SAMPLE_RATE_HZ        1000
+#define POTS_DIAG_MS_TO_SAMPLES(ms)     ((uint32_t)(ms) * POTS_DIAG_SAMPLE_RATE_HZ / 1000U)
+
+/* Open circuit: the input is pulled up to the rail */
+#define POTS_DIAG_OPEN_RAW              4050
+/* Short to ground: the input is tied to 0 V */
+#define POTS_DIAG_SHORT_RAW             45
+/* Stuck: raw samples do not move by more than this band for the whole stuck time while
+ * the heater is on. A live analog input always shows some LSBs of noise. The heal is
+ * checked whatever the heater does */
+#define POTS_DIAG_STUCK_BAND_RAW        0
+#define POTS_DIAG_STUCK_TIME_MS         10000
+/* Rate of change: the median filtered value moves by more than this many codes within
+ * one rate interval (45 codes ~ 0.5 C with the development board potentiometers) */
+#define POTS_DIAG_RATE_INTERVAL_MS      100
+#define POTS_DIAG_RATE_MAX_RAW          45
+
+/* Debounce (consecutive bad checks to set) and heal (consecutive good checks to clear).
+ * Open/short are checked on every sample, the rate on every rate interval and stuck once
+ * per stuck time */
+#define POTS_DIAG_OPEN_SHORT_DEBOUNCE   50
+#define POTS_DIAG_OPEN_SHORT_HEAL       500
+#define POTS_DIAG_RATE_DEBOUNCE         2
+#define POTS_DIAG_RATE_HEAL             20
+#define POTS_DIAG_STUCK_DEBOUNCE        1
+#define POTS_DIAG_STUCK_HEAL            1
+
+/* Fault bits of one channel, channels are packed POTS_DIAG_BITS_PER_CHANNEL apart in the
+ * bitmap returned by POTS_getDiagFaults() */
+#define POTS_DIAG_OPEN                  0x1U
+#define POTS_DIAG_SHORT                 0x2U
+#define POTS_DIAG_STUCK                 0x4U
+#define POTS_DIAG_RATE                  0x8U
+#define POTS_DIAG_BITS_PER_CHANNEL      4
+#define POTS_DIAG_CHANNEL_FAULTS(bitmap, ch) \
+        (((bitmap) >> ((ch) * POTS_DIAG_BITS_PER_CHANNEL)) & 0xFU)
+
+typedef enum {
+    POTS_DIAG_CHECK_OPEN, POTS_DIAG_CHECK_SHORT, POTS_DIAG_CHECK_STUCK, POTS_DIAG_CHECK_RATE,
+    POTS_DIAG_NUM_CHECKS
+} POTS_DiagCheckType;
+
+typedef struct {
+    uint16_t ui16Debounce;
+    uint16_t ui16Heal;
+} POTS_DiagCounterType;
+
+typedef struct {
+    POTS_DiagCounterType psCounter[POTS_DIAG_NUM_CHECKS];
+    uint8_t ui8Faults;
+    bool bHeating;
+    uint16_t ui16StuckMin;
+    uint16_t ui16StuckMax;
+    uint32_t ui32StuckSamples;
+    uint16_t ui16RateReference;
+    uint16_t ui16RateSamples;
+} POTS_DiagStateType;
+
+void POTS_diagInit(POTS_DiagStateType *psDiag, uint16_t ui16InitialValue);
+uint8_t POTS_diagUpdate(POTS_DiagStateType *psDiag, uint16_t ui16Raw, uint16_t ui16Median);
+
+
+#endif /* HAL_POTS_POTS_DIAG_H_ */
@@ -0,0 +1,63 @@
+/*
+ * pots_filter.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include <HAL/POTS/pots_filter.h>
+#include <stdint.h>
+
+/* The stages only touch the state passed to them and have no hardware dependency so
+ * they can be compiled and benchmarked on the host as they are */
+
+void POTS_filterInit(POTS_FilterStateType *psFilter, uint16_t ui16InitialValue){
+    uint8_t ui8Index;
+
+    for(ui8Index = 0; ui8Index < POTS_FILTER_MEDIAN_SIZE; ui8Index++){
+        psFilter->pui16MedianWindow[ui8Index] = ui16InitialValue;
+    }
+    psFilter->ui8MedianIndex = 0;
+    psFilter->i32IirState = (int32_t)ui16InitialValue << POTS_FILTER_IIR_FRAC_BITS;
+}
+
+/* Push a sample into the window and return the median of the window */
+uint16_t POTS_filterMedian(POTS_FilterStateType *psFilter, uint16_t ui16Sample){
+#if (POTS_FILTER_MEDIAN_SIZE > 1)
+    uint16_t pui16Sorted[POTS_FILTER_MEDIAN_SIZE];
+    uint16_t ui16Value;
+    uint8_t ui8Index;
+    int8_t i8Position;
+
+    psFilter->pui16MedianWindow[psFilter->ui8MedianIndex] = ui16Sample;
+    if(++psFilter->ui8MedianIndex == POTS_FILTER_MEDIAN_SIZE){
+        psFilter->ui8MedianIndex = 0;
+    }
+
+    /* Insertion sort of a copy, the window is small enough for it to beat anything smarter */
+    for(ui8Index = 0; ui8Index < POTS_FILTER_MEDIAN_SIZE; ui8Index++){
+        ui16Value = psFilter->pui16MedianWindow[ui8Index];
+        for(i8Position = (int8_t)ui8Index - 1; (i8Position >= 0) && (pui16Sorted[i8Position] > ui16Value); i8Position--){
+            pui16Sorted[i8Position + 1] = pui16Sorted[i8Position];
+        }
+        pui16Sorted[i8Position + 1] = ui16Value;
+    }
+    return pui16Sorted[POTS_FILTER_MEDIAN_SIZE / 2];
+#else
+    (void)psFilter;
+    return ui16Sample;
+#endif
+}
+
+/* Single pole low pass: y += (x - y) >> POTS_FILTER_IIR_SHIFT with y in Q16 */
+uint16_t POTS_filterIir(POTS_FilterStateType *psFilter, uint16_t ui16Sample){
+#if (POTS_FILTER_IIR_SHIFT > 0)
+    int32_t i32Input = (int32_t)ui16Sample << POTS_FILTER_IIR_FRAC_BITS;
+
+    psFilter->i32IirState += (i32Input - psFilter->i32IirState) >> POTS_FILTER_IIR_SHIFT;
+    return (uint16_t)((psFilter->i32IirState + (1 << (POTS_FILTER_IIR_FRAC_BITS - 1))) >> POTS_FILTER_IIR_FRAC_BITS);
+#else
+    (void)psFilter;
+    return ui16Sample;
+#endif
+}
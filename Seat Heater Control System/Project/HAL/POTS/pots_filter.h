@@ -0,0 +1,38 @@
+/*
+ * pots_filter.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef HAL_POTS_POTS_FILTER_H_
+#define HAL_POTS_POTS_FILTER_H_
+
+#include <stdint.h>
+
+/* Filtering pipeline applied to every seat channel, all stages are integer only:
+ * 1. ADC hardware oversampling: the ADC averages POTS_FILTER_HW_OVERSAMPLE conversions
+ *    per sample (0 disables it, otherwise 2, 4, 8, 16, 32 or 64).
+ * 2. Sliding median over the last POTS_FILTER_MEDIAN_SIZE samples to reject spikes
+ *    (1 disables it, otherwise an odd number up to 7).
+ * 3. Block decimation done by the acquisition stream.
+ * 4. Single pole IIR y += (x - y) / 2^POTS_FILTER_IIR_SHIFT kept in Q16
+ *    (0 disables it). */
+#define POTS_FILTER_HW_OVERSAMPLE   8
+#define POTS_FILTER_MEDIAN_SIZE     5
+#define POTS_FILTER_IIR_SHIFT       2
+
+#define POTS_FILTER_IIR_FRAC_BITS   16
+
+typedef struct {
+    uint16_t pui16MedianWindow[POTS_FILTER_MEDIAN_SIZE];
+    uint8_t ui8MedianIndex;
+    int32_t i32IirState;
+} POTS_FilterStateType;
+
+void POTS_filterInit(POTS_FilterStateType *psFilter, uint16_t ui16InitialValue);
+uint16_t POTS_filterMedian(POTS_FilterStateType *psFilter, uint16_t ui16Sample);
+uint16_t POTS_filterIir(POTS_FilterStateType *psFilter, uint16_t ui16Sample);
+
+
+#endif /* HAL_POTS_POTS_FILTER_H_ */
@@ -0,0 +1,53 @@
+/*
+ * pots_lut.c
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#include <HAL/POTS/pots_lut.h>
+#include <HAL/POTS/pots_lut_table.h>
+#include <stdint.h>
+
+#if (POTS_SENSOR_MODEL == POTS_SENSOR_NTC)
+#define POTS_LUT_TABLE   pi16PotsLutNtcTable
+#else
+#define POTS_LUT_TABLE   pi16PotsLutPotTable
+#endif
+
+#define POTS_LUT_FRAC_MASK   ((1U << POTS_LUT_SEGMENT_SHIFT) - 1U)
+
+/* Piecewise linear interpolation between the two table points around the raw code.
+ * Segments are a power of 2 codes wide so there is no division on this path */
+int16_t POTS_lutToTempQ8(uint16_t ui16Raw){
+    uint16_t ui16Index;
+    int32_t i32Low;
+    int32_t i32High;
+
+    ui16Raw &= 0x0FFF;
+    ui16Index = ui16Raw >> POTS_LUT_SEGMENT_SHIFT;
+    i32Low = POTS_LUT_TABLE[ui16Index];
+    i32High = POTS_LUT_TABLE[ui16Index + 1];
+
+    return (int16_t)(i32Low + (((i32High - i32Low) * (int32_t)(ui16Raw & POTS_LUT_FRAC_MASK)) >> POTS_LUT_SEGMENT_SHIFT));
+}
+
+/* Lowest and highest raw codes whose temperature is inside [i16MinTempQ8, i16MaxTempQ8].
+ * Meant for initialization only, it walks the whole ADC range */
+void POTS_lutFindWindow(int16_t i16MinTempQ8, int16_t i16MaxTempQ8,
+                        uint16_t *pui16RawLow, uint16_t *pui16RawHigh){
+    uint16_t ui16Raw;
+    int16_t i16TempQ8;
+
+    *pui16RawLow = 0x0FFF;
+    *pui16RawHigh = 0;
+    for(ui16Raw = 0; ui16Raw <= 0x0FFF; ui16Raw++){
+        i16TempQ8 = POTS_lutToTempQ8(ui16Raw);
+        if((i16TempQ8 >= i16MinTempQ8) && (i16TempQ8 <= i16MaxTempQ8)){
+            if(ui16Raw < *pui16RawLow){
+                *pui16RawLow = ui16Raw;
+            }
+            *pui16RawHigh = ui16Raw;
+        }
+    }
+}
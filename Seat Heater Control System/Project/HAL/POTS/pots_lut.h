@@ -0,0 +1,30 @@
+/*
+ * pots_lut.h
+ *
+ *  Created on: October , 2026
+ *  Author    : Ahmed Surror
+ */
+
+#ifndef HAL_POTS_POTS_LUT_H_
+#define HAL_POTS_POTS_LUT_H_
+
+#include <stdint.h>
+
+/* Sensor fitted on the seats, selects the linearization table generated by
+ * Tools/gen_pots_lut.py into pots_lut_table.h:
+ * POTS_SENSOR_POT --> development board potentiometers, 0 .. 45 C linear
+ * POTS_SENSOR_NTC --> production Beta-model NTC thermistors */
+#define POTS_SENSOR_POT      0
+#define POTS_SENSOR_NTC      1
+
+#define POTS_SENSOR_MODEL    POTS_SENSOR_POT
+
+/* Temperatures are returned in Q8 C (1/256 C per LSB) */
+#define POTS_TEMP_Q8_SHIFT   8
+
+int16_t POTS_lutToTempQ8(uint16_t ui16Raw);
+void POTS_lutFindWindow(int16_t i16MinTempQ8, int16_t i16MaxTempQ8,
+                        uint16_t *pui16RawLow, uint16_t *pui16RawHigh);
+
+
+#endif /* HAL_POTS_POTS_LUT_H_ */
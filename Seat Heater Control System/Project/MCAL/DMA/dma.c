@@ -0,0 +1,39 @@
+ /******************************************************************************
+ *
+ * Module: DMA
+ *
+ * File Name: dma.c
+ *
+ * Description: Source file for the TM4C123GH6PM uDMA controller setup shared by
+ *              all the drivers that stream data through uDMA channels
+ *
+ * Author: Ahmed Surror
+ *
+ *******************************************************************************/
+
+#include "dma.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+#pragma DATA_ALIGN(ui8DMAControlTable, DMA_CONTROL_TABLE_SIZE)
+static uint8 ui8DMAControlTable[DMA_CONTROL_TABLE_SIZE];
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+void DMA_Init(void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA));   /* Wait until uDMA clock is activated and it is ready for access*/
+
+    uDMAEnable();
+    uDMAControlBaseSet(ui8DMAControlTable);
+}
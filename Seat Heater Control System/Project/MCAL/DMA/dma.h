@@ -0,0 +1,33 @@
+ /******************************************************************************
+ *
+ * Module: DMA
+ *
+ * File Name: dma.h
+ *
+ * Description: Header file for the TM4C123GH6PM uDMA controller setup shared by
+ *              all the drivers that stream data through uDMA channels
+ *
+ * Author: Ahmed Surror
+ *
+ *******************************************************************************/
+
+#ifndef DMA_H_
+#define DMA_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+
+/* The control table must hold the primary and alternate structures of all the
+ * 32 channels and must be aligned on a 1024-byte boundary */
+#define DMA_CONTROL_TABLE_SIZE   1024
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+extern void DMA_Init(void);
+
+#endif /* DMA_H_ */
@@ -117,8 +117,7 @@ uint8 GPIO_EXTSWGetState(){
 void GPIO_SW1EdgeTriggeredInterruptInit(void)
 {
     GPIO_PORTF_IS_REG    &= ~(1<<4);      /* PF4 detect edges */
-    GPIO_PORTF_IBE_REG   &= ~(1<<4);      /* PF4 will detect a certain edge */
-    GPIO_PORTF_IEV_REG   &= ~(1<<4);      /* PF4 will detect a falling edge */
+    GPIO_PORTF_IBE_REG   |= (1<<4);       /* PF4 will detect both edges: press and release */
     GPIO_PORTF_ICR_REG   |= (1<<4);       /* Clear Trigger flag for PF4 (Interrupt Flag) */
     GPIO_PORTF_IM_REG    |= (1<<4);       /* Enable Interrupt on PF4 pin */
     /* Set GPIO PORTF priority as 5 by set Bit number 21, 22 and 23 with value 2 */
@@ -129,11 +128,21 @@ void GPIO_SW1EdgeTriggeredInterruptInit(void)
 void GPIO_SW2EdgeTriggeredInterruptInit(void)
 {
     GPIO_PORTF_IS_REG    &= ~(1<<0);      /* PF0 detect edges */
-    GPIO_PORTF_IBE_REG   &= ~(1<<0);      /* PF0 will detect a certain edge */
-    GPIO_PORTF_IEV_REG   &= ~(1<<0);      /* PF0 will detect a falling edge */
+    GPIO_PORTF_IBE_REG   |= (1<<0);       /* PF0 will detect both edges: press and release */
     GPIO_PORTF_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PF0 (Interrupt Flag) */
     GPIO_PORTF_IM_REG    |= (1<<0);       /* Enable Interrupt on PF0 pin */
     /* Set GPIO PORTF priority as 5 by set Bit number 21, 22 and 23 with value 2 */
     NVIC_PRI7_REG = (NVIC_PRI7_REG & GPIO_PORTF_PRIORITY_MASK) | (GPIO_PORTF_INTERRUPT_PRIORITY<<GPIO_PORTF_PRIORITY_BITS_POS);
     NVIC_EN0_REG         |= 0x40000000;   /* Enable NVIC Interrupt for GPIO PORTF by set bit number 30 in EN0 Register */
 }
+
+void GPIO_EXTSWEdgeTriggeredInterruptInit(void)
+{
+    GPIO_PORTB_IS_REG    &= ~(1<<0);      /* PB0 detect edges */
+    GPIO_PORTB_IBE_REG   |= (1<<0);       /* PB0 will detect both edges: press and release */
+    GPIO_PORTB_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PB0 (Interrupt Flag) */
+    GPIO_PORTB_IM_REG    |= (1<<0);       /* Enable Interrupt on PB0 pin */
+    /* Set GPIO PORTB priority as 5 by set Bit number 13, 14 and 15 with value 5 */
+    NVIC_PRI0_REG = (NVIC_PRI0_REG & GPIO_PORTB_PRIORITY_MASK) | (GPIO_PORTB_INTERRUPT_PRIORITY<<GPIO_PORTB_PRIORITY_BITS_POS);
+    NVIC_EN0_REG         |= 0x00000002;   /* Enable NVIC Interrupt for GPIO PORTB by set bit number 1 in EN0 Register */
+}
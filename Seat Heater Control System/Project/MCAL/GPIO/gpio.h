@@ -19,6 +19,10 @@
 #define GPIO_PORTF_PRIORITY_BITS_POS  21
 #define GPIO_PORTF_INTERRUPT_PRIORITY 5
 
+#define GPIO_PORTB_PRIORITY_MASK      0xFFFF1FFF
+#define GPIO_PORTB_PRIORITY_BITS_POS  13
+#define GPIO_PORTB_INTERRUPT_PRIORITY 5
+
 #define EXT_BUTTON_GPIO_PERIPH      SYSCTL_PERIPH_GPIOB
 #define EXT_BUTTON_GPIO_BASE        GPIO_PORTB_BASE
 #define EXT_BUTTON              GPIO_PIN_0
@@ -47,5 +51,6 @@ uint8 GPIO_EXTSWGetState(void);
 
 void GPIO_SW1EdgeTriggeredInterruptInit(void);
 void GPIO_SW2EdgeTriggeredInterruptInit(void);
+void GPIO_EXTSWEdgeTriggeredInterruptInit(void);
 
 #endif /* GPIO_H_ */
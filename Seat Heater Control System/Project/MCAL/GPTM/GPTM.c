@@ -28,3 +28,22 @@ uint32 GPTM_WTimer0Read(void)
     return (uint32) (0xFFFFFFFFUL - WTIMER0_TAR_REG);
 }
 
+void GPTM_WTimer1FreeRunInit(void)
+{
+    /* Configure periodic down 32bit timer with tick time = 1usec that wraps around every ~71 minutes,
+     * readers compute elapsed times with unsigned subtraction. Counting down as WTimer0: counting
+     * up, the prescaler only extends the timer and the clock would not be divided */
+    SYSCTL_RCGCWTIMER_REG |= (1<<1);  /* Enable clock WTimer1 in run mode */
+    while(!(SYSCTL_PRWTIMER_REG & (1<<1)));
+    WTIMER1_CTL_REG = 0;              /* Disable WTimer1 output */
+    WTIMER1_CFG_REG = 0x04;           /* Select 32-bit configuration option */
+    WTIMER1_TAMR_REG = 0x02;          /* Select periodic down counter mode of WTimer1A */
+    WTIMER1_TAILR_REG = 0xFFFFFFFF;   /* Count over the full 32-bit range */
+    WTIMER1_TAPR_REG = 16 -1;         /* Set the prescaler for WTimer1A */
+    WTIMER1_CTL_REG |= (0x01);        /* Enable WTimer1A module */
+}
+
+uint32 GPTM_WTimer1Read(void)
+{
+    return (uint32) (0xFFFFFFFFUL - WTIMER1_TAR_REG);
+}
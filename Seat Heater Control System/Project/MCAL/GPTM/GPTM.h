@@ -15,8 +15,14 @@
 
 #include "std_types.h"
 
+/* WTimer1 free-running time base used to timestamp samples and events */
+#define GPTM_TIMESTAMP_TICKS_PER_MS   (1000U)     /* 1 usec per tick */
+
 void GPTM_WTimer0Init(void);
 uint32 GPTM_WTimer0Read(void);
 
+void GPTM_WTimer1FreeRunInit(void);
+uint32 GPTM_WTimer1Read(void);
+
 
 #endif /* GPTM_H_ */
@@ -11,7 +11,41 @@
  *******************************************************************************/
 
 #include "uart0.h"
+#include "fmt.h"
 #include "tm4c123gh6pm_registers.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_uart.h"
+#include "driverlib/udma.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*******************************************************************************
+ *                              Private Variables                              *
+ *******************************************************************************/
+
+#define UART0_TX_INDEX_MASK      (UART0_TX_BUFFER_SIZE - 1)
+
+/* Free running indices, g_uTxHead - g_uTxTail bytes are waiting. The head is only moved by
+ * the sender (one task at a time, the callers serialize with their mutex), the tail by the
+ * TX interrupt or by the sender inside a critical section */
+static uint8 g_uTxBuffer[UART0_TX_BUFFER_SIZE];
+static volatile uint32 g_uTxHead = 0;
+static volatile uint32 g_uTxTail = 0;
+
+static uint8 g_uTxPolicy = UART0_TX_DEFAULT_POLICY;
+static TickType_t g_xTxTimeout = pdMS_TO_TICKS(UART0_TX_DEFAULT_TIMEOUT_MS);
+static volatile uint32 g_uTxDropped = 0;
+static volatile TaskHandle_t g_xTxWaitingTask = NULL;
+
+/* uDMA transmission: busy from UART0_SendBufferDMA() until pfDone is called, running while
+ * the uDMA owns the TX FIFO (it waits for the ring buffer to drain first) */
+static const uint8 *g_pTxDmaNext;         /* first byte not programmed yet */
+static volatile uint32 g_uTxDmaLeft = 0;  /* bytes not programmed yet */
+static void (*g_pfTxDmaDone)(void);
+static volatile boolean g_bTxDmaBusy = FALSE;
+static volatile boolean g_bTxDmaRunning = FALSE;
 
 /*******************************************************************************
  *                         Private Functions Definitions                       *
@@ -31,6 +65,166 @@ static void GPIO_SetupUART0Pins(void)
     GPIO_PORTA_DEN_REG   |= 0x03;         /* Enable Digital I/O on PA0 & PA1 */
 }
 
+/* Move bytes from the ring buffer to the TX FIFO until the FIFO is full or the ring empty,
+ * called from the TX interrupt or inside a critical section */
+static void UART0_FillTxFifo(void)
+{
+    while((g_uTxTail != g_uTxHead) && !(UART0_FR_REG & UART_FR_TXFF_MASK))
+    {
+        UART0_DR_REG = g_uTxBuffer[g_uTxTail & UART0_TX_INDEX_MASK];
+        g_uTxTail++;
+    }
+}
+
+/* Prime the FIFO and let the TX interrupt take over: it only fires when the FIFO level
+ * drops through the trigger, so an idle transmitter has to be started from here */
+static void UART0_StartTx(void)
+{
+    taskENTER_CRITICAL();
+    if(!g_bTxDmaRunning)  /* Otherwise resumed by the uDMA completion */
+    {
+        UART0_FillTxFifo();
+        if(g_uTxTail != g_uTxHead)
+        {
+            UART0_IM_REG |= UART_INT_TX_MASK;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/* Program the next chunk of the uDMA buffer into one half of the ping-pong pair, the last
+ * chunk is a basic transfer so the channel stops after it */
+static void UART0_DmaProgram(uint32 uSelect)
+{
+    uint32 uChunk = (g_uTxDmaLeft > UART0_DMA_MAX_TRANSFER) ? UART0_DMA_MAX_TRANSFER : g_uTxDmaLeft;
+
+    g_uTxDmaLeft -= uChunk;
+    uDMAChannelTransferSet(UDMA_CHANNEL_UART0TX | uSelect,
+                           (g_uTxDmaLeft != 0) ? UDMA_MODE_PINGPONG : UDMA_MODE_BASIC,
+                           (void *)g_pTxDmaNext, (void *)(UART0_BASE + UART_O_DR), uChunk);
+    g_pTxDmaNext += uChunk;
+}
+
+/* Hand the TX FIFO to the uDMA, called with the ring buffer empty from a critical section or
+ * from the UART0 interrupt */
+static void UART0_DmaStart(void)
+{
+    g_bTxDmaRunning = TRUE;
+    UART0_IM_REG &= ~UART_INT_TX_MASK;
+
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_UART0TX, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_4);
+    uDMAChannelControlSet(UDMA_CHANNEL_UART0TX | UDMA_ALT_SELECT,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_4);
+    UART0_DmaProgram(UDMA_PRI_SELECT);
+    if(g_uTxDmaLeft != 0)
+    {
+        UART0_DmaProgram(UDMA_ALT_SELECT);
+    }
+    uDMAChannelEnable(UDMA_CHANNEL_UART0TX);
+    UART0_DMACTL_REG |= UART_DMACTL_TXDMAE_MASK;
+}
+
+/* uDMA part of the UART0 interrupt: a half of the pair completed, returns TRUE while the
+ * uDMA still owns the TX FIFO */
+static boolean UART0_DmaService(void)
+{
+    void (*pfDone)(void);
+
+    if(g_uTxDmaLeft != 0)
+    {
+        if(uDMAChannelModeGet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT) == UDMA_MODE_STOP)
+        {
+            UART0_DmaProgram(UDMA_PRI_SELECT);
+        }
+        if((g_uTxDmaLeft != 0) && (uDMAChannelModeGet(UDMA_CHANNEL_UART0TX | UDMA_ALT_SELECT) == UDMA_MODE_STOP))
+        {
+            UART0_DmaProgram(UDMA_ALT_SELECT);
+        }
+        return TRUE;
+    }
+    if(uDMAChannelIsEnabled(UDMA_CHANNEL_UART0TX))
+    {
+        return TRUE;    /* Last chunk still running */
+    }
+
+    /* Done: the last bytes are in the FIFO, the buffer is free again */
+    UART0_DMACTL_REG &= ~UART_DMACTL_TXDMAE_MASK;
+    g_bTxDmaRunning = FALSE;
+    g_bTxDmaBusy = FALSE;
+    pfDone = g_pfTxDmaDone;
+    if(pfDone != NULL)
+    {
+        pfDone();
+    }
+    return FALSE;
+}
+
+/* Ring buffer full: apply the policy, returns FALSE when the remaining bytes are discarded */
+static boolean UART0_MakeRoom(void)
+{
+    UART0_StartTx();
+
+    switch(g_uTxPolicy)
+    {
+    case UART0_TX_OVERWRITE:
+        taskENTER_CRITICAL();
+        if((g_uTxHead - g_uTxTail) == UART0_TX_BUFFER_SIZE)
+        {
+            g_uTxTail++;
+            g_uTxDropped++;
+        }
+        taskEXIT_CRITICAL();
+        return TRUE;
+
+    case UART0_TX_BLOCK:
+        /* Registered before checking again, a notification given in between is not lost */
+        g_xTxWaitingTask = xTaskGetCurrentTaskHandle();
+        while((g_uTxHead - g_uTxTail) == UART0_TX_BUFFER_SIZE)
+        {
+            if(ulTaskNotifyTake(pdTRUE, g_xTxTimeout) == 0)
+            {
+                break;
+            }
+        }
+        g_xTxWaitingTask = NULL;
+        return ((g_uTxHead - g_uTxTail) < UART0_TX_BUFFER_SIZE) ? TRUE : FALSE;
+
+    default:
+        return FALSE;
+    }
+}
+
+/* Copy into the ring buffer and start the transmission, returns without waiting for it */
+static void UART0_Write(const uint8 *pData, uint32 uLength)
+{
+    uint32 uIndex = 0;
+
+    while(uIndex < uLength)
+    {
+        uint32 uFree = UART0_TX_BUFFER_SIZE - (g_uTxHead - g_uTxTail);
+
+        if(uFree == 0)
+        {
+            if(!UART0_MakeRoom())
+            {
+                g_uTxDropped += uLength - uIndex;
+                break;
+            }
+            continue;
+        }
+        while((uFree > 0) && (uIndex < uLength))
+        {
+            g_uTxBuffer[g_uTxHead & UART0_TX_INDEX_MASK] = pData[uIndex];
+            g_uTxHead++;
+            uIndex++;
+            uFree--;
+        }
+    }
+    UART0_StartTx();
+}
+
 /*******************************************************************************
  *                         Public Functions Definitions                        *
  *******************************************************************************/
@@ -56,11 +250,19 @@ void UART0_Init(void) /* UART0 configuration: 1 start, 8 bits data, No Parity, 1
      * PEN = 0 Disable Parity
      * EPS = 0 No affect as the parity is disabled
      * STP2 = 0 1-stop bit at end of the frame
-     * FEN = 0 FIFOs are disabled
+     * FEN = 1 FIFOs are enabled
      * WLEN = 0x3 8-bits data frame
      * SPS = 0 no stick parity
      */
-    UART0_LCRH_REG = (UART_DATA_8BITS << UART_LCRH_WLEN_BITS_POS);
+    UART0_LCRH_REG = (UART_DATA_8BITS << UART_LCRH_WLEN_BITS_POS) | UART_LCRH_FEN_MASK;
+
+    /* TX interrupt when the FIFO drops to 4 bytes, it stays masked while there is nothing to send */
+    UART0_IFLS_REG = UART_IFLS_TX_1_4;
+    UART0_IM_REG   = 0;
+    UART0_ICR_REG  = UART_INT_TX_MASK;
+    /* Set UART0 priority as 5 by set Bit number 13, 14 and 15 with value 5 */
+    NVIC_PRI1_REG = (NVIC_PRI1_REG & UART0_PRIORITY_MASK) | (UART0_INTERRUPT_PRIORITY<<UART0_PRIORITY_BITS_POS);
+    NVIC_EN0_REG |= UART0_NVIC_EN0_MASK;  /* Enable NVIC Interrupt for UART0 by set bit number 5 in EN0 Register */
     
     /* UART Control Register Settings
      * RXE = 1 Enable UART Receive
@@ -73,8 +275,7 @@ void UART0_Init(void) /* UART0 configuration: 1 start, 8 bits data, No Parity, 1
        
 void UART0_SendByte(uint8 data)
 {
-    while(!(UART0_FR_REG & UART_FR_TXFE_MASK)); /* Wait until the transmit FIFO is empty */
-    UART0_DR_REG = data; /* Send the byte */
+    UART0_Write(&data, 1); /* Queue the byte */
 }
 
 uint8 UART0_ReceiveByte(void)
@@ -86,38 +287,113 @@ uint8 UART0_ReceiveByte(void)
 void UART0_SendString(const uint8 *pData)
 {
     uint32 uCounter =0;
-	/* Transmit the whole string */
+    /* Find the end of the string and queue it at once */
     while(pData[uCounter] != '\0')
     {
-        UART0_SendByte(pData[uCounter]); /* Send the byte */
         uCounter++; /* increment the counter to the next byte */
     }
+    UART0_Write(pData, uCounter);
+}
+
+/* Decimal text of the number, formatted in 32 bits by Common/fmt.c and queued at once */
+void UART0_SendInteger(sint32 sNumber)
+{
+    uint8 uDigits[FMT_S32_MAX_SIZE];
+
+    UART0_Write(uDigits, FMT_s32(uDigits, sNumber));
+}
+
+/* Binary data, may contain '\0' */
+void UART0_SendBuffer(const uint8 *pData, uint32 uLength)
+{
+    UART0_Write(pData, uLength);
 }
 
-void UART0_SendInteger(sint64 sNumber)
+void UART0_SetTxPolicy(uint8 uPolicy, uint32 uTimeoutMs)
 {
+    g_uTxPolicy = uPolicy;
+    g_xTxTimeout = pdMS_TO_TICKS(uTimeoutMs);
+}
 
-    uint8 uDigits[20];
-    sint8 uCounter = 0;
+/* Number of bytes discarded by the policy since start up */
+uint32 UART0_GetTxDropped(void)
+{
+    return g_uTxDropped;
+}
+
+/* Queue a whole buffer for the uDMA, returns FALSE while a previous one is still busy. The
+ * buffer must stay untouched until pfDone (may be NULL) is called from the UART0 interrupt,
+ * which should only wake a task: the next buffer is queued from task context */
+boolean UART0_SendBufferDMA(const uint8 *pData, uint32 uLength, void (*pfDone)(void))
+{
+    if(uLength == 0)
+    {
+        return FALSE;
+    }
 
-    /* Send the negative sign in case of negative numbers */
-    if (sNumber < 0)
+    taskENTER_CRITICAL();
+    if(g_bTxDmaBusy)
     {
-        UART0_SendByte('-');
-        sNumber *= -1;
+        taskEXIT_CRITICAL();
+        return FALSE;
     }
+    g_bTxDmaBusy = TRUE;
+    g_pTxDmaNext = pData;
+    g_uTxDmaLeft = uLength;
+    g_pfTxDmaDone = pfDone;
+    if(g_uTxTail == g_uTxHead)
+    {
+        UART0_DmaStart();   /* Otherwise started by the interrupt once the ring buffer is empty */
+    }
+    taskEXIT_CRITICAL();
+    return TRUE;
+}
 
-    /* Convert the number to an array of characters */
-    do
+/* Transmission with the CPU waiting on the FIFO for every byte, as before the ring buffer.
+ * Only for an idle transmitter (UART0_IsTxIdle()) */
+void UART0_SendBufferPolled(const uint8 *pData, uint32 uLength)
+{
+    uint32 uCounter;
+
+    for(uCounter = 0; uCounter < uLength; uCounter++)
     {
-        uDigits[uCounter++] = sNumber % 10 + '0'; /* Convert each digit to its corresponding ASCI character */
-        sNumber /= 10; /* Remove the already converted digit */
+        while(UART0_FR_REG & UART_FR_TXFF_MASK); /* Wait until there is room in the transmit FIFO */
+        UART0_DR_REG = pData[uCounter];
     }
-    while (sNumber != 0);
+}
+
+/* Nothing queued in any mode and the last stop bit is out */
+boolean UART0_IsTxIdle(void)
+{
+    return ((g_uTxTail == g_uTxHead) && !g_bTxDmaBusy && !(UART0_FR_REG & UART_FR_BUSY_MASK)) ? TRUE : FALSE;
+}
+
+/* UART0 interrupt: refill the TX FIFO from the ring buffer or re-arm the uDMA, and wake a
+ * blocked sender. The uDMA completion of the TX channel arrives here as well */
+void UART0_TxHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-    /* Send the array of characters in a reverse order as the digits were converted from right to left */
-    for( uCounter--; uCounter>= 0; uCounter--)
+    UART0_ICR_REG = UART_INT_TX_MASK;
+    if(!g_bTxDmaRunning || !UART0_DmaService())
+    {
+        UART0_FillTxFifo();
+        if(g_uTxTail != g_uTxHead)
+        {
+            UART0_IM_REG |= UART_INT_TX_MASK;
+        }
+        else if(g_bTxDmaBusy)
+        {
+            UART0_DmaStart();   /* Ring buffer drained, the queued uDMA buffer goes next */
+        }
+        else
+        {
+            UART0_IM_REG &= ~UART_INT_TX_MASK; /* Nothing left, idle until the next UART0_StartTx() */
+        }
+    }
+    if(g_xTxWaitingTask != NULL)
     {
-        UART0_SendByte(uDigits[uCounter]);
+        vTaskNotifyGiveFromISR(g_xTxWaitingTask, &xHigherPriorityTaskWoken);
     }
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
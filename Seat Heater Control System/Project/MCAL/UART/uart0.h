@@ -27,7 +27,42 @@
 #define UART_CTL_TXE_MASK        0x00000100
 #define UART_CTL_RXE_MASK        0x00000200
 #define UART_FR_TXFE_MASK        0x00000080
+#define UART_FR_TXFF_MASK        0x00000020
+#define UART_FR_BUSY_MASK        0x00000008
 #define UART_FR_RXFE_MASK        0x00000010
+#define UART_LCRH_FEN_MASK       0x00000010
+#define UART_IFLS_TX_1_4         0x00000001   /* TX interrupt when the FIFO drops to 4 bytes */
+#define UART_INT_TX_MASK         0x00000020   /* TXIM / TXMIS / TXIC */
+#define UART_DMACTL_TXDMAE_MASK  0x00000002
+
+#define UART0_PRIORITY_MASK      0xFFFF1FFF
+#define UART0_PRIORITY_BITS_POS  13
+#define UART0_INTERRUPT_PRIORITY 5
+#define UART0_NVIC_EN0_MASK      0x00000020
+
+/* Transmit ring buffer drained by the UART0 TX interrupt, the send functions only copy into
+ * it and return. Holds a whole status dump, must be a power of two */
+#define UART0_TX_BUFFER_SIZE     512
+
+/* What a send does with the bytes that do not fit in the ring buffer:
+ * UART0_TX_DROP      --> the new bytes are discarded
+ * UART0_TX_BLOCK     --> the calling task sleeps until the interrupt frees space, at most the
+ *                        timeout per wait, then discards what still does not fit
+ * UART0_TX_OVERWRITE --> the oldest bytes not yet handed to the FIFO are discarded
+ * Every discarded byte is counted, see UART0_GetTxDropped() */
+#define UART0_TX_DROP            0
+#define UART0_TX_BLOCK           1
+#define UART0_TX_OVERWRITE       2
+
+/* Policy until UART0_SetTxPolicy() is called: nothing is lost while the receiver keeps up */
+#define UART0_TX_DEFAULT_POLICY      UART0_TX_BLOCK
+#define UART0_TX_DEFAULT_TIMEOUT_MS  100
+
+/* Bulk transmission: UART0_SendBufferDMA() hands a whole buffer to the uDMA UART0 TX channel,
+ * the CPU is only interrupted every UART0_DMA_MAX_TRANSFER bytes to re-arm the idle half of
+ * the ping-pong pair. It is sent after the text already in the ring buffer, text queued
+ * while it runs follows it */
+#define UART0_DMA_MAX_TRANSFER   1024
 
 /*******************************************************************************
  *                            Functions Prototypes                             *
@@ -41,6 +76,20 @@ extern uint8 UART0_ReceiveByte(void);
 
 extern void UART0_SendString(const uint8 *pData);
 
-extern void UART0_SendInteger(sint64 sNumber);
+extern void UART0_SendInteger(sint32 sNumber);
+
+extern void UART0_SendBuffer(const uint8 *pData, uint32 uLength);
+
+extern void UART0_SetTxPolicy(uint8 uPolicy, uint32 uTimeoutMs);
+
+extern uint32 UART0_GetTxDropped(void);
+
+extern boolean UART0_SendBufferDMA(const uint8 *pData, uint32 uLength, void (*pfDone)(void));
+
+extern void UART0_SendBufferPolled(const uint8 *pData, uint32 uLength);
+
+extern boolean UART0_IsTxIdle(void);
+
+extern void UART0_TxHandler(void);
 
 #endif
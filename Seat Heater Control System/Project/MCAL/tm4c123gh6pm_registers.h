@@ -452,4 +452,18 @@ Timer Registers (WTIMER0)
 #define WTIMER0_TAR_REG           (*((volatile uint32 *)0x40036048))
 #define WTIMER0_TBR_REG           (*((volatile uint32 *)0x4003604C))
 
+/*****************************************************************************
+Timer Registers (WTIMER1)
+*****************************************************************************/
+#define WTIMER1_CFG_REG           (*((volatile uint32 *)0x40037000))
+#define WTIMER1_TAMR_REG          (*((volatile uint32 *)0x40037004))
+#define WTIMER1_TBMR_REG          (*((volatile uint32 *)0x40037008))
+#define WTIMER1_CTL_REG           (*((volatile uint32 *)0x4003700C))
+#define WTIMER1_TAILR_REG         (*((volatile uint32 *)0x40037028))
+#define WTIMER1_TBILR_REG         (*((volatile uint32 *)0x4003702C))
+#define WTIMER1_TAPR_REG          (*((volatile uint32 *)0x40037038))
+#define WTIMER1_TBPR_REG          (*((volatile uint32 *)0x4003703C))
+#define WTIMER1_TAR_REG           (*((volatile uint32 *)0x40037048))
+#define WTIMER1_TBR_REG           (*((volatile uint32 *)0x4003704C))
+
 #endif
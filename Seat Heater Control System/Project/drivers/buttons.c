@@ -51,6 +51,56 @@
 //*****************************************************************************
 static uint8_t g_ui8ButtonStates = ALL_BUTTONS ;
 
+//*****************************************************************************
+//
+// Buttons that are not on port F, with the bit each one takes in the button
+// state.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32Base;
+    uint32_t ui32Periph;
+    uint8_t ui8Pin;
+    uint8_t ui8Button;
+}
+tButtonPin;
+
+static const tButtonPin g_psExtraButtons[] =
+{
+    { EXTERNAL_BUTTON_GPIO_BASE, EXTERNAL_BUTTON_GPIO_PERIPH,
+      EXTERNAL_BUTTON_GPIO_PIN, EXTERNAL_BUTTON },
+};
+
+#define NUM_EXTRA_BUTTONS                                                     \
+        (sizeof(g_psExtraButtons) / sizeof(g_psExtraButtons[0]))
+
+//*****************************************************************************
+//
+// Reads the raw state of every button, a 0 in a bit indicates that the
+// button is pressed.  Bits that are not buttons read as released.
+//
+//*****************************************************************************
+static uint32_t
+ButtonsRead(void)
+{
+    uint32_t ui32Data;
+    uint32_t ui32Idx;
+
+    ui32Data = (MAP_GPIOPinRead(BUTTONS_GPIO_BASE, BUTTONS_GPIO_PINS) |
+                (ALL_BUTTONS & ~BUTTONS_GPIO_PINS));
+    for(ui32Idx = 0; ui32Idx < NUM_EXTRA_BUTTONS; ui32Idx++)
+    {
+        if(MAP_GPIOPinRead(g_psExtraButtons[ui32Idx].ui32Base,
+                           g_psExtraButtons[ui32Idx].ui8Pin) == 0)
+        {
+            ui32Data &= ~g_psExtraButtons[ui32Idx].ui8Button;
+        }
+    }
+
+    return(ui32Data);
+}
+
 //*****************************************************************************
 //
 //! Polls the current state of the buttons and determines which have changed.
@@ -93,10 +143,10 @@ ButtonsPoll(uint8_t *pui8Delta, uint8_t *pui8RawState)
     // (inverting the bit sense) if the caller supplied storage for the
     // raw value.
     //
-    ui32Data = (MAP_GPIOPinRead(BUTTONS_GPIO_BASE, ALL_BUTTONS));
+    ui32Data = ButtonsRead();
     if(pui8RawState)
     {
-        *pui8RawState = (uint8_t)~ui32Data;
+        *pui8RawState = (uint8_t)(~ui32Data & ALL_BUTTONS);
     }
 
     //
@@ -142,7 +192,7 @@ ButtonsPoll(uint8_t *pui8Delta, uint8_t *pui8RawState)
     // sense so that a '1' indicates the button is pressed, which is a
     // sensible way to interpret the return value.
     //
-    return(~g_ui8ButtonStates);
+    return(~g_ui8ButtonStates & ALL_BUTTONS);
 }
 
 //*****************************************************************************
@@ -160,6 +210,8 @@ ButtonsPoll(uint8_t *pui8Delta, uint8_t *pui8RawState)
 void
 ButtonsInit(void)
 {
+    uint32_t ui32Idx;
+
     //
     // Enable the GPIO port to which the pushbuttons are connected.
     //
@@ -177,17 +229,29 @@ ButtonsInit(void)
     //
     // Set each of the button GPIO pins as an input with a pull-up.
     //
-    MAP_GPIODirModeSet(BUTTONS_GPIO_BASE, ALL_BUTTONS, GPIO_DIR_MODE_IN);
+    MAP_GPIODirModeSet(BUTTONS_GPIO_BASE, BUTTONS_GPIO_PINS, GPIO_DIR_MODE_IN);
 
-    MAP_GPIOPadConfigSet(BUTTONS_GPIO_BASE, ALL_BUTTONS,
+    MAP_GPIOPadConfigSet(BUTTONS_GPIO_BASE, BUTTONS_GPIO_PINS,
                          GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
 
+    //
+    // Same for the buttons on the other ports.
+    //
+    for(ui32Idx = 0; ui32Idx < NUM_EXTRA_BUTTONS; ui32Idx++)
+    {
+        MAP_SysCtlPeripheralEnable(g_psExtraButtons[ui32Idx].ui32Periph);
+        MAP_GPIODirModeSet(g_psExtraButtons[ui32Idx].ui32Base,
+                           g_psExtraButtons[ui32Idx].ui8Pin, GPIO_DIR_MODE_IN);
+        MAP_GPIOPadConfigSet(g_psExtraButtons[ui32Idx].ui32Base,
+                             g_psExtraButtons[ui32Idx].ui8Pin,
+                             GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+    }
 
     //
     // Initialize the debounced button state with the current state read from
     // the GPIO bank.
     //
-    g_ui8ButtonStates = MAP_GPIOPinRead(BUTTONS_GPIO_BASE, ALL_BUTTONS);
+    g_ui8ButtonStates = ButtonsRead();
 }
 
 //*****************************************************************************
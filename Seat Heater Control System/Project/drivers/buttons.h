@@ -44,19 +44,31 @@ extern "C"
 //
 // PF4 - Left Button
 // PF0 - Right Button
+// PB0 - External Button
 //
 // The switches tie the GPIO to ground, so the GPIOs need to be configured
 // with pull-ups, and a value of 0 means the switch is pressed.
 //
+// The buttons on port F keep their pin bit in the button state.  Buttons on
+// other ports are listed in g_psExtraButtons[] of buttons.c and are given one
+// of the bits left free by port F, so all of them are still debounced by the
+// same vertical counter.
+//
 //*****************************************************************************
 #define BUTTONS_GPIO_PERIPH         SYSCTL_PERIPH_GPIOF
 #define BUTTONS_GPIO_BASE           GPIO_PORTF_BASE
+#define BUTTONS_GPIO_PINS           (LEFT_BUTTON | RIGHT_BUTTON)
+
+#define EXTERNAL_BUTTON_GPIO_PERIPH SYSCTL_PERIPH_GPIOB
+#define EXTERNAL_BUTTON_GPIO_BASE   GPIO_PORTB_BASE
+#define EXTERNAL_BUTTON_GPIO_PIN    GPIO_PIN_0
 
-#define NUM_BUTTONS             2
+#define NUM_BUTTONS             3
 #define LEFT_BUTTON             GPIO_PIN_4
 #define RIGHT_BUTTON            GPIO_PIN_0
+#define EXTERNAL_BUTTON         0x02
 
-#define ALL_BUTTONS             (LEFT_BUTTON | RIGHT_BUTTON )
+#define ALL_BUTTONS             (LEFT_BUTTON | RIGHT_BUTTON | EXTERNAL_BUTTON)
 
 //*****************************************************************************
 //
@@ -8,6 +8,8 @@
 #ifndef HEATINGSYSTEM_H_
 #define HEATINGSYSTEM_H_
 
+#include <stdint.h>
+
 typedef enum HeatingLevelType {
     HEATING_OFF, HEATING_LOW, HEATING_MEDIUM, HEATING_HIGH
 } HeatingLevelType;
@@ -16,14 +18,20 @@ typedef enum HeaterStateType {
     HEATER_OFF, HEATER_LOW, HEATER_MEDIUM, HEATER_HIGH
 } HeaterStateType;
 
+/* Number of heated zones handled by the seat control engine, each one is
+ * described by an entry of the seat configuration table (APP/SEAT/seat_cfg.c) */
+#define SEAT_COUNT  2
+
 typedef struct {
-    uint8_t ui8Seat1TempValueC;
-    HeatingLevelType Seat1heatingLevel;
-    HeaterStateType Seat1heaterState;
+    uint8_t ui8TempValueC;
+    HeatingLevelType heatingLevel;
+    HeaterStateType heaterState;
+    uint16_t ui16RequestedDutyQ15;  /* duty cycle asked by the controller, 0 .. 32767 */
+    uint16_t ui16HeaterDutyQ15;     /* duty cycle granted by the power arbiter and applied */
+}SeatStateType;
 
-    uint8_t ui8Seat2TempValueC;
-    HeatingLevelType Seat2heatingLevel;
-    HeaterStateType Seat2heaterState;
+typedef struct {
+    SeatStateType Seats[SEAT_COUNT];
 }SystemStateStructureType;
 
 
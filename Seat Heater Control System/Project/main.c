@@ -4,79 +4,137 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
+#include "queue.h"
+#include "event_groups.h"
 #include "GPTM.h"
 #include "gpio.h"
 #include "uart0.h"
+#include "MCAL/DMA/dma.h"
 #include "HAL/RGB_LED/rgb.h"
+#include "HAL/HEATER/heater.h"
+#include "HAL/INPUT/input.h"
+#include "APP/SEAT/seat.h"
+#include "APP/TELEMETRY/telemetry.h"
+#include "APP/LOG/log.h"
+#include "fmt.h"
 
 /* Defines the periodicity of runtime measurements task */
 #define RUNTIME_MEASUREMENTS_TASK_PERIODICITY (1000U)
 
+/* Status output of vDisplaySystemStateTask:
+ * DISPLAY_MODE_BINARY --> COBS framed records (APP/TELEMETRY) read with Tools/telemetry_decode.
+ *                         Every DISPLAY_DELTA_PERIOD_MS only the fields that changed are sent,
+ *                         nothing at all in steady state, and a heating level change is sent
+ *                         as soon as the input task notifies it. A full keyframe of about 33
+ *                         bytes follows every DISPLAY_KEYFRAME_PERIOD_MS for a receiver that
+ *                         connected late or lost a record
+ * DISPLAY_MODE_TEXT   --> human readable dump every second for debugging on a terminal */
+#define DISPLAY_MODE_TEXT                     (0U)
+#define DISPLAY_MODE_BINARY                   (1U)
+#define DISPLAY_MODE                          DISPLAY_MODE_BINARY
+
+#define DISPLAY_DELTA_PERIOD_MS               (100U)
+#define DISPLAY_KEYFRAME_PERIOD_MS            (5000U)
+
+/* Diagnostics go through the deferred log (APP/LOG): vLogDrainTask sends the records at the
+ * lowest priority, as TELEMETRY_RECORD_LOG frames read with Tools/log_decode, or as text
+ * lines in DISPLAY_MODE_TEXT */
+#define LOG_DRAIN_PERIOD_MS                   (50U)
+
+/* Set to 1 to compare the UART0 transmit modes once at start up: the same report is sent
+ * polled, through the interrupt driven ring buffer and through the uDMA, each result gives
+ * the throughput and the CPU share taken from a spinning lowest priority task */
+#define UART0_TX_BENCHMARK                    (0U)
+#define UART0_BENCHMARK_REPORT_SIZE           (1024U)
+#define UART0_BENCHMARK_BASELINE_MS           (1000U)
+
 /* Task prototypes */
 static void prvSetupHardware(void);
 void vDisplaySystemStateTask(void *pvParameters);
 void vcpuLoadMeasurementTask(void *pvParameters);
 void vtasksTimeMeasurementTask(void *pvParameters);
-void vSeat1AdjustHeaterTask(void *pvParameters);
-void vSeat2AdjustHeaterTask(void *pvParameters);
-void vgetSeat1CurrentTempTask(void *pvParameters);
-void vgetSeat2CurrentTempTask(void *pvParameters);
-void vCheckSeat1HeatingLevelChange(void *pvParameters);
-void vCheckSeat2HeatingLevelChange(void *pvParameters);
+void vSeatsControlTask(void *pvParameters);
+void vSeatsInputTask(void *pvParameters);
+void vLogDrainTask(void *pvParameters);
+#if UART0_TX_BENCHMARK
+void vUart0BenchmarkTask(void *pvParameters);
+void vUart0BenchmarkSpinTask(void *pvParameters);
+#endif
 
 /* Global variables */
-SystemStateStructureType SystemState = {0, HEATING_OFF, HEATER_OFF, 0, HEATING_OFF, HEATER_OFF};
+/* Zero initialized: every seat starts at 0C, HEATING_OFF and HEATER_OFF */
+SystemStateStructureType SystemState;
 
 /* Tasks Handlers */
 TaskHandle_t vDisplaySystemStateTaskHandle;
 TaskHandle_t vcpuLoadMeasurementTaskHandle;
 TaskHandle_t vtasksTimeMeasurementTaskHandle;
-TaskHandle_t vSeat1AdjustHeaterHandle;
-TaskHandle_t vSeat2AdjustHeaterHandle;
-TaskHandle_t vgetSeat1CurrentTempTaskHandle;
-TaskHandle_t vgetSeat2CurrentTempTaskHandle;
-TaskHandle_t vCheckSeat1HeatingLevelChangeHandle;
-TaskHandle_t vCheckSeat2HeatingLevelChangeHandle;
+TaskHandle_t vSeatsControlTaskHandle;
+TaskHandle_t vSeatsInputTaskHandle;
+TaskHandle_t vLogDrainTaskHandle;
+#if UART0_TX_BENCHMARK
+TaskHandle_t vUart0BenchmarkTaskHandle;
+TaskHandle_t vUart0BenchmarkSpinTaskHandle;
+#endif
 
 /* Semaphores */
 xSemaphoreHandle xMutex;
+#if (DISPLAY_MODE == DISPLAY_MODE_BINARY)
+/* Wakes the display task on a heating level change. Not a task notification: the display
+ * task also waits on its notification inside UART0_SendBuffer() when UART0 is full */
+xSemaphoreHandle xDisplayWakeSemaphore;
+#endif
+
+/* Events shared between the drivers and the seat tasks */
+EventGroupHandle_t xSeatEventGroup;
+
+/* Debounced button presses and releases from the input poll timer */
+QueueHandle_t xInputEventQueue;
 
 /* Arrays to store task execution times */
 uint32 ullTasksOutTime[10];
 uint32 ullTasksInTime[10];
 uint32 ullTasksTotalTime[10];
 
+/* Last CPU load computed by vcpuLoadMeasurementTask, in % */
+uint8 ui8CpuLoadPercent;
+
 
 int main()
 {
+    /* Create the event group and the queue before the drivers that publish to them */
+    xSeatEventGroup = xEventGroupCreate();
+    xInputEventQueue = xQueueCreate(INPUT_QUEUE_LENGTH, sizeof(INPUT_EventType));
+
     /* Setup the hardware for use with the Tiva C board. */
     prvSetupHardware();
 
     /* Create a mutex semaphore */
     xMutex = xSemaphoreCreateMutex();
+#if (DISPLAY_MODE == DISPLAY_MODE_BINARY)
+    xDisplayWakeSemaphore = xSemaphoreCreateBinary();
+#endif
 
     /* Create tasks */
 
     xTaskCreate(vtasksTimeMeasurementTask, "Tasks Time Measurements Task", 256, NULL, 1, &vtasksTimeMeasurementTaskHandle);
     xTaskCreate(vcpuLoadMeasurementTask, "CPU Load Measurement Task", 32, NULL, 2, &vcpuLoadMeasurementTaskHandle);
-    xTaskCreate(vDisplaySystemStateTask, "Displaying System State Task", 32, (void*)&SystemState, 2, &vDisplaySystemStateTaskHandle);
-    xTaskCreate(vSeat1AdjustHeaterTask, "Adjusting Seat 1 Heater Intensity Task", 32, (void*)&SystemState, 2, &vSeat1AdjustHeaterHandle);
-    xTaskCreate(vSeat2AdjustHeaterTask, "Adjusting Seat 2 Heater Intensity Task", 32, (void*)&SystemState, 2, &vSeat2AdjustHeaterHandle);
-    xTaskCreate(vgetSeat1CurrentTempTask, "Getting Seat 1 Current Temperature Task", 32, (void*)&SystemState, 2, &vgetSeat1CurrentTempTaskHandle);
-    xTaskCreate(vgetSeat2CurrentTempTask, "Getting Seat 2 Current Temperature Task", 32, (void*)&SystemState, 2, &vgetSeat2CurrentTempTaskHandle);
-    xTaskCreate(vCheckSeat1HeatingLevelChange, "Getting Seat 1 Heating Level Changes Task", 32, (void*)&SystemState, 3, &vCheckSeat1HeatingLevelChangeHandle);
-    xTaskCreate(vCheckSeat2HeatingLevelChange, "Getting Seat 2 Heating Level Changes Task", 32, (void*)&SystemState, 3, &vCheckSeat2HeatingLevelChangeHandle);
+    xTaskCreate(vDisplaySystemStateTask, "Displaying System State Task", 64, (void*)&SystemState, 2, &vDisplaySystemStateTaskHandle);
+    xTaskCreate(vSeatsControlTask, "Seats Control Task", 64, NULL, 3, &vSeatsControlTaskHandle);
+    xTaskCreate(vSeatsInputTask, "Seats Input Task", 64, NULL, 3, &vSeatsInputTaskHandle);
+    xTaskCreate(vLogDrainTask, "Log Drain Task", 128, NULL, 1, &vLogDrainTaskHandle);
+#if UART0_TX_BENCHMARK
+    xTaskCreate(vUart0BenchmarkTask, "UART0 Benchmark Task", 128, NULL, 4, &vUart0BenchmarkTaskHandle);
+    xTaskCreate(vUart0BenchmarkSpinTask, "UART0 Benchmark Spin Task", 32, NULL, 1, &vUart0BenchmarkSpinTaskHandle);
+#endif
 
 
     vTaskSetApplicationTaskTag( vtasksTimeMeasurementTaskHandle, ( TaskHookFunction_t ) 1 );
     vTaskSetApplicationTaskTag( vcpuLoadMeasurementTaskHandle, ( TaskHookFunction_t ) 2 );
     vTaskSetApplicationTaskTag( vDisplaySystemStateTaskHandle, ( TaskHookFunction_t ) 3 );
-    vTaskSetApplicationTaskTag( vSeat1AdjustHeaterHandle, ( TaskHookFunction_t ) 4 );
-    vTaskSetApplicationTaskTag( vSeat2AdjustHeaterHandle, ( TaskHookFunction_t ) 5 );
-    vTaskSetApplicationTaskTag( vgetSeat1CurrentTempTaskHandle, ( TaskHookFunction_t ) 6 );
-    vTaskSetApplicationTaskTag( vgetSeat2CurrentTempTaskHandle, ( TaskHookFunction_t ) 7 );
-    vTaskSetApplicationTaskTag( vCheckSeat1HeatingLevelChangeHandle, ( TaskHookFunction_t ) 8 );
-    vTaskSetApplicationTaskTag( vCheckSeat2HeatingLevelChangeHandle, ( TaskHookFunction_t ) 9 );
+    vTaskSetApplicationTaskTag( vSeatsControlTaskHandle, ( TaskHookFunction_t ) 4 );
+    vTaskSetApplicationTaskTag( vSeatsInputTaskHandle, ( TaskHookFunction_t ) 5 );
+    vTaskSetApplicationTaskTag( vLogDrainTaskHandle, ( TaskHookFunction_t ) 6 );
 
     /* Start the FreeRTOS scheduler */
     vTaskStartScheduler();
@@ -93,9 +151,14 @@ static void prvSetupHardware( void )
     /* Place here any needed HW initialization such as GPIO, UART, etc.  */
     UART0_Init();
     GPTM_WTimer0Init();
+    GPTM_WTimer1FreeRunInit();
     GPIO_BuiltinButtonsLedsInit();
-    POT1_init();
+    INPUT_init(xInputEventQueue);
+    DMA_Init();
+    POTS_init(xSeatEventGroup);
     RGB_init();
+    HEATER_init();
+    SEAT_init(&SystemState);
 
     RGB_RedLedOff();
     RGB_GreenLedOff();
@@ -112,43 +175,11 @@ void vtasksTimeMeasurementTask(void *pvParameters){
 
     vTaskDelay(pdMS_TO_TICKS(2000));
 
-    if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
-        UART0_SendString("CPU Load Measurement Task execution time is ");
-        UART0_SendInteger(ullTasksTotalTime[2] / 10);
-        UART0_SendString(" msec \r\n");
-
-        UART0_SendString("Display System State Task execution time is ");
-        UART0_SendInteger(ullTasksTotalTime[3] / 10);
-        UART0_SendString(" msec \r\n");
-
-        UART0_SendString("Adjusting Seat 1 Heater Intensity Task execution time is ");
-        UART0_SendInteger(ullTasksTotalTime[4] / 10);
-        UART0_SendString(" msec \r\n");
-
-        UART0_SendString("Adjusting Seat 2 Heater Intensity Task execution time is ");
-        UART0_SendInteger(ullTasksTotalTime[5] / 10);
-        UART0_SendString(" msec \r\n");
-
-        UART0_SendString("Getting Seat 1 Current Temperature Task execution time is ");
-        UART0_SendInteger(ullTasksTotalTime[6] / 10);
-        UART0_SendString(" msec \r\n");
-
-        UART0_SendString("Getting Seat 2 Current Temperature Task execution time is ");
-        UART0_SendInteger(ullTasksTotalTime[7] / 10);
-        UART0_SendString(" msec \r\n");
-
-        UART0_SendString("Getting Seat 1 Heating Level Changes Task execution time is ");
-        UART0_SendInteger(ullTasksTotalTime[8] / 10);
-        UART0_SendString(" msec \r\n");
-
-        UART0_SendString("Getting Seat 2 Heating Level Changes Task execution time is ");
-        UART0_SendInteger(ullTasksTotalTime[9] / 10);
-        UART0_SendString(" msec \r\n");
-        xSemaphoreGive(xMutex); // Give back the semaphore here
-        vTaskDelete(NULL);
-    }
-
-
+    LOG1(LOG_MSG_CPU_LOAD_TASK_TIME, ullTasksTotalTime[2] / 10);
+    LOG1(LOG_MSG_DISPLAY_TASK_TIME, ullTasksTotalTime[3] / 10);
+    LOG1(LOG_MSG_CONTROL_TASK_TIME, ullTasksTotalTime[4] / 10);
+    LOG1(LOG_MSG_INPUT_TASK_TIME, ullTasksTotalTime[5] / 10);
+    vTaskDelete(NULL);
 }
 
 /* Task to measure CPU load */
@@ -157,378 +188,367 @@ void vcpuLoadMeasurementTask(void *pvParameters)
     TickType_t xLastWakeTime = xTaskGetTickCount();
     for (;;)
     {
-        if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
-            uint8_t ucCounter, ucCPU_Load;
-            uint32_t ullTotalTasksTime = 0;
+        uint8_t ucCounter, ucCPU_Load;
+        uint32_t ullTotalTasksTime = 0;
 
-            for(ucCounter = 1; ucCounter < 9; ucCounter++)
-            {
-                ullTotalTasksTime += ullTasksTotalTime[ucCounter];
-            }
-            ucCPU_Load = (ullTotalTasksTime * 100) /  GPTM_WTimer0Read();
+        for(ucCounter = 1; ucCounter < 9; ucCounter++)
+        {
+            ullTotalTasksTime += ullTasksTotalTime[ucCounter];
+        }
+        ucCPU_Load = (ullTotalTasksTime * 100) /  GPTM_WTimer0Read();
+        ui8CpuLoadPercent = ucCPU_Load;
+
+#if (DISPLAY_MODE == DISPLAY_MODE_TEXT)
+        /* Part of the status records otherwise */
+        LOG1(LOG_MSG_CPU_LOAD, ucCPU_Load);
+#endif
+
+        vTaskDelayUntil(&xLastWakeTime, RUNTIME_MEASUREMENTS_TASK_PERIODICITY);
+    }
+}
 
-            taskENTER_CRITICAL();
-            UART0_SendString("------------------------ CPU Load is ");
-            UART0_SendInteger(ucCPU_Load);
-            UART0_SendString("%  ---------------------------\r\n");
-            taskEXIT_CRITICAL();
+#if (DISPLAY_MODE == DISPLAY_MODE_TEXT)
+/* Human readable dump of the state of every seat */
+static void vDisplaySystemStateText(const SystemStateStructureType* systemState)
+{
+    uint8 pui8Text[FMT_Q32_MAX_SIZE];
+    uint8_t ui8Seat;
+
+    for (ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        UART0_SendString("Seat");
+        UART0_SendInteger(ui8Seat + 1);
+        UART0_SendString(" Temperature: ");
+        UART0_SendBuffer(pui8Text, FMT_u32Pad(pui8Text, systemState->Seats[ui8Seat].ui8TempValueC, 3, ' '));
+        UART0_SendString((ui8Seat == SEAT_COUNT - 1) ? "C\r\n" : "C\t\t|\t");
+    }
 
-            xSemaphoreGive(xMutex); // Give back the semaphore here
+    for (ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        UART0_SendString("Seat");
+        UART0_SendInteger(ui8Seat + 1);
+        UART0_SendString(" Heating Level: ");
+        switch (systemState->Seats[ui8Seat].heatingLevel) {
+        case HEATING_OFF:
+            UART0_SendString("OFF");
+            break;
+        case HEATING_LOW:
+            UART0_SendString("LOW");
+            break;
+        case HEATING_MEDIUM:
+            UART0_SendString("MEDIUM");
+            break;
+        case HEATING_HIGH:
+            UART0_SendString("HIGH");
+            break;
+        default:
+            break;
         }
+        UART0_SendString((ui8Seat == SEAT_COUNT - 1) ? "\r\n" : "\t|\t");
+    }
 
-        vTaskDelayUntil(&xLastWakeTime, RUNTIME_MEASUREMENTS_TASK_PERIODICITY);
+    for (ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        UART0_SendString("Seat");
+        UART0_SendInteger(ui8Seat + 1);
+        UART0_SendString(" Heater Intensity: ");
+        switch (systemState->Seats[ui8Seat].heaterState) {
+        case HEATER_OFF:
+            UART0_SendString("OFF");
+            break;
+        case HEATER_LOW:
+            UART0_SendString("LOW");
+            break;
+        case HEATER_MEDIUM:
+            UART0_SendString("MEDIUM");
+            break;
+        case HEATER_HIGH:
+            UART0_SendString("HIGH");
+            break;
+        default:
+            break;
+        }
+        /* Applied duty, Q15 fraction times 100 printed as a percentage */
+        UART0_SendString(" (");
+        UART0_SendBuffer(pui8Text, FMT_q32(pui8Text, (sint32)systemState->Seats[ui8Seat].ui16HeaterDutyQ15 * 100, 15, 1));
+        UART0_SendString((ui8Seat == SEAT_COUNT - 1) ? "%)\r\n" : "%)\t|\t");
+    }
+
+    UART0_SendString("Heaters Current: ");
+    UART0_SendInteger(POWER_getGrantedMa());
+    UART0_SendString(" mA granted / ");
+    UART0_SendInteger(POWER_getRequestedMa());
+    UART0_SendString(" mA requested\r\n");
+
+    UART0_SendString("=====================================================================\r\n");
+}
+#else
+/* Frame of the state of every seat, static: too large for the stack of the task */
+static uint8 pui8TelemetryFrame[TELEMETRY_MAX_FRAME_SIZE];
+
+/* Keyframe or changed fields, the frame is built outside of xMutex which is only taken
+ * when there is something to send */
+static void vDisplaySystemStateBinary(const SystemStateStructureType* systemState, boolean bKeyframe)
+{
+    TELEMETRY_StatusType sStatus;
+    uint32 ui32Length;
+
+    sStatus.ui32TimestampMs = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    sStatus.ui8CpuLoadPercent = ui8CpuLoadPercent;
+    sStatus.ui16GrantedMa = (uint16)POWER_getGrantedMa();
+    sStatus.ui16RequestedMa = (uint16)POWER_getRequestedMa();
+    if (bKeyframe) {
+        ui32Length = TELEMETRY_buildStateFrame(systemState, &sStatus, pui8TelemetryFrame);
+    } else {
+        ui32Length = TELEMETRY_buildDeltaFrame(systemState, &sStatus, pui8TelemetryFrame);
+    }
+
+    if ((ui32Length != 0) && (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE)) {
+        UART0_SendBuffer(pui8TelemetryFrame, ui32Length);
+        xSemaphoreGive(xMutex);
     }
 }
+#endif
 
 /* Task to display system state */
 void vDisplaySystemStateTask(void *pvParameters)
 {
     SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
+#if (DISPLAY_MODE == DISPLAY_MODE_TEXT)
     TickType_t xLastWakeTime = xTaskGetTickCount();
     for (;;) {
         if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
-            UART0_SendString("Seat1 Temperature: ");
-            UART0_SendInteger(systemState->ui8Seat1TempValueC);
-            UART0_SendString("C\t\t|\t");
-            UART0_SendString("Seat2 Temperature: ");
-            UART0_SendInteger(systemState->ui8Seat2TempValueC);
-            UART0_SendString("C\r\n");
-
-            UART0_SendString("Seat1 Heating Level: ");
-            switch (systemState->Seat1heatingLevel) {
-            case HEATING_OFF:
-                UART0_SendString("OFF\t|\t");
-                break;
-            case HEATING_LOW:
-                UART0_SendString("LOW\t|\t");
-                break;
-            case HEATING_MEDIUM:
-                UART0_SendString("MEDIUM\t|\t");
-                break;
-            case HEATING_HIGH:
-                UART0_SendString("HIGH\t|\t");
-                break;
-            default:
-                break;
-            }
-
-            UART0_SendString("Seat2 Heating Level: ");
-            switch (systemState->Seat2heatingLevel) {
-            case HEATING_OFF:
-                UART0_SendString("OFF\r\n");
-                break;
-            case HEATING_LOW:
-                UART0_SendString("LOW\r\n");
-                break;
-            case HEATING_MEDIUM:
-                UART0_SendString("MEDIUM\r\n");
-                break;
-            case HEATING_HIGH:
-                UART0_SendString("HIGH\r\n");
-                break;
-            default:
-                break;
-            }
-
-            UART0_SendString("Seat1 Heater Intensity: ");
-            switch (systemState->Seat1heaterState) {
-            case HEATER_OFF:
-                UART0_SendString("OFF\t|\t");
-                break;
-            case HEATER_LOW:
-                UART0_SendString("LOW\t|\t");
-                break;
-            case HEATER_MEDIUM:
-                UART0_SendString("MEDIUM\t|\t");
-                break;
-            case HEATING_HIGH:
-                UART0_SendString("HIGH\t|\t");
-                break;
-            default:
-                break;
-            }
-
-            UART0_SendString("Seat2 Heater Intensity: ");
-            switch (systemState->Seat2heaterState) {
-            case HEATER_OFF:
-                UART0_SendString("OFF\r\n");
-                break;
-            case HEATER_LOW:
-                UART0_SendString("LOW\r\n");
-                break;
-            case HEATER_MEDIUM:
-                UART0_SendString("MEDIUM\r\n");
-                break;
-            case HEATING_HIGH:
-                UART0_SendString("HIGH\r\n");
-                break;
-            default:
-                break;
-            }
-
-            UART0_SendString("=====================================================================\r\n");
+            vDisplaySystemStateText(systemState);
             xSemaphoreGive(xMutex);
             vTaskDelayUntil( &xLastWakeTime, pdMS_TO_TICKS( 1000 ) );
 
         }
     }
+#else
+    TickType_t xLastKeyframe = xTaskGetTickCount();
+    boolean bKeyframe = TRUE;
+    for (;;) {
+        vDisplaySystemStateBinary(systemState, bKeyframe);
+        if (bKeyframe) {
+            xLastKeyframe = xTaskGetTickCount();
+        }
+
+        /* Woken early by a heating level change of the input task */
+        xSemaphoreTake(xDisplayWakeSemaphore, pdMS_TO_TICKS( DISPLAY_DELTA_PERIOD_MS ));
+        bKeyframe = ((xTaskGetTickCount() - xLastKeyframe) >= pdMS_TO_TICKS( DISPLAY_KEYFRAME_PERIOD_MS )) ? TRUE : FALSE;
+    }
+#endif
 }
 
-/* Task to adjust heater for Seat 1 */
-void vgetSeat1CurrentTempTask(void *pvParameters)
+/* Control engine: adjusts the heater of every seat described in psSeatConfig[], then shares
+ * the supply budget between the seat heaters. It only runs when a temperature leaves its
+ * deadband, a sensor fault or a heating level changes, or a PID seat needs its next period.
+ * The cost grows linearly with SEAT_COUNT */
+void vSeatsControlTask(void *pvParameters)
 {
-    SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
-    uint8_t ui8seat1CurrentTempValueC;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint8_t ui8Seat;
+    uint32 ui32Now;
     for (;;) {
-        ui8seat1CurrentTempValueC = (POT1_getValue() * 45) / POT1_MAX_VALUE;
-        systemState->ui8Seat1TempValueC = ui8seat1CurrentTempValueC;
-        vTaskDelayUntil( &xLastWakeTime, pdMS_TO_TICKS( 100 ) );
+        ui32Now = GPTM_WTimer1Read();
+        for (ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+            SEAT_adjustHeater(ui8Seat, ui32Now);
+        }
+        SEAT_applyPower();
+        xEventGroupWaitBits(xSeatEventGroup, SEAT_getEventMask(), pdTRUE, pdFALSE, pdMS_TO_TICKS( SEAT_getTimeoutMs() ));
     }
-
 }
 
-/* Task to adjust heater for Seat 2 */
-void vgetSeat2CurrentTempTask(void *pvParameters)
+/* Consumes the debounced presses and releases queued by the input poll timer (HAL/INPUT)
+ * and steps the heating levels from the recognized gestures, the control engine is only
+ * woken up when a level changed. The task sleeps without timeout while no gesture is
+ * pending and no button is held */
+void vSeatsInputTask(void *pvParameters)
 {
-    SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
-    uint8_t ui8seat2CurrentTempValueC;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    INPUT_EventType sEvent;
+    BaseType_t xEvent;
+    uint32 ui32Now;
+    uint32 ui32Events;
+    uint32 ui32TimeoutMs;
     for (;;) {
-        ui8seat2CurrentTempValueC = (POT2_getValue() * 45) / POT2_MAX_VALUE;
-        systemState->ui8Seat2TempValueC = ui8seat2CurrentTempValueC;
-        vTaskDelayUntil( &xLastWakeTime, pdMS_TO_TICKS( 100 ) );
+        ui32TimeoutMs = SEAT_getButtonTimeoutMs(GPTM_WTimer1Read());
+        xEvent = xQueueReceive(xInputEventQueue, &sEvent,
+                               (ui32TimeoutMs == SEAT_NO_TIMEOUT) ? portMAX_DELAY : pdMS_TO_TICKS( ui32TimeoutMs ));
+
+        ui32Now = GPTM_WTimer1Read();
+        ui32Events = 0;
+        if (xEvent == pdTRUE) {
+            ui32Events |= SEAT_buttonEvent(sEvent.ui8Button, sEvent.bPressed, sEvent.ui32Timestamp);
+        }
+        ui32Events |= SEAT_buttonTimeout(ui32Now);
+        if (ui32Events != 0) {
+            xEventGroupSetBits(xSeatEventGroup, ui32Events);
+#if (DISPLAY_MODE == DISPLAY_MODE_BINARY)
+            xSemaphoreGive(xDisplayWakeSemaphore);
+#endif
+        }
     }
-
 }
 
-/* Task to get current temperature of Seat 1 */
-void vSeat1AdjustHeaterTask(void *pvParameters)
+#if (DISPLAY_MODE == DISPLAY_MODE_TEXT)
+static uint8 pui8LogText[LOG_MAX_TEXT_SIZE];
+#else
+static uint8 pui8LogFrame[LOG_MAX_FRAME_SIZE];
+#endif
+
+/* Sends the deferred log records, at the lowest priority so the records are formatted or
+ * framed while nothing else runs. xMutex is only held for each send */
+void vLogDrainTask(void *pvParameters)
 {
-    SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
-    uint8_t ui8seat1DesiredTempValueC;
-    uint8_t ui8seat1CurrentTempValueC;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint32 ui32UartDropped = 0;
+    uint32 ui32Length;
+#if (DISPLAY_MODE == DISPLAY_MODE_TEXT)
+    uint32 ui32LogDropped = 0;
+#endif
     for (;;) {
-        switch (systemState->Seat1heatingLevel) {
-        case HEATING_LOW:
-            ui8seat1DesiredTempValueC = 25;
-            break;
-        case HEATING_MEDIUM:
-            ui8seat1DesiredTempValueC = 30;
-            break;
-        case HEATING_HIGH:
-            ui8seat1DesiredTempValueC = 35;
-            break;
-        default:
-            break;
+        vTaskDelay(pdMS_TO_TICKS( LOG_DRAIN_PERIOD_MS ));
+
+        if (UART0_GetTxDropped() != ui32UartDropped) {
+            ui32UartDropped = UART0_GetTxDropped();
+            LOG1(LOG_MSG_UART_TX_DROPPED, ui32UartDropped);
         }
-        ui8seat1CurrentTempValueC = systemState->ui8Seat1TempValueC;
-
-
-        if(ui8seat1CurrentTempValueC <= 40 && ui8seat1CurrentTempValueC >= 5){
-
-            if((ui8seat1DesiredTempValueC > ui8seat1CurrentTempValueC) && ((systemState->Seat1heatingLevel) != HEATING_OFF)){
-
-                if((ui8seat1DesiredTempValueC - ui8seat1CurrentTempValueC) >= 10){
-                    systemState->Seat1heaterState = HEATER_HIGH;
-
-                    RGB_RedLedOff();
-                    RGB_GreenLedOn();
-                    RGB_BlueLedOff();
-
-                }
-                else if((ui8seat1DesiredTempValueC - ui8seat1CurrentTempValueC) >= 5){
-                    systemState->Seat1heaterState = HEATER_MEDIUM;
-                    RGB_RedLedOff();
-                    RGB_GreenLedOff();
-                    RGB_BlueLedOn();
-                }
-                else if(
-                        (((ui8seat1DesiredTempValueC - ui8seat1CurrentTempValueC) >= 2) && (systemState->Seat1heaterState != HEATER_OFF)) ||
-                        (((ui8seat1DesiredTempValueC - ui8seat1CurrentTempValueC) > 3) && (systemState->Seat1heaterState == HEATER_OFF))
-                )
-                {
-                    systemState->Seat1heaterState = HEATER_LOW;
-                    RGB_RedLedOff();
-                    RGB_GreenLedOn();
-                    RGB_BlueLedOn();
-                }
-                else{
-                    systemState->Seat1heaterState = HEATER_OFF;
-                    RGB_GreenLedOff();
-                    RGB_BlueLedOff();
-                }
-            }
-            else{
-                systemState->Seat1heaterState = HEATER_OFF;
-                RGB_RedLedOff();
-                RGB_GreenLedOff();
-                RGB_BlueLedOff();
+#if (DISPLAY_MODE == DISPLAY_MODE_TEXT)
+        while ((ui32Length = LOG_popText(pui8LogText)) != 0) {
+#else
+        while ((ui32Length = LOG_buildFrame(pui8LogFrame)) != 0) {
+#endif
+            if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
+#if (DISPLAY_MODE == DISPLAY_MODE_TEXT)
+                UART0_SendBuffer(pui8LogText, ui32Length);
+#else
+                UART0_SendBuffer(pui8LogFrame, ui32Length);
+#endif
+                xSemaphoreGive(xMutex);
             }
         }
-        else{
-            systemState->Seat1heaterState = HEATER_OFF;
-            RGB_RedLedOn();
-            RGB_GreenLedOff();
-            RGB_BlueLedOff();
+#if (DISPLAY_MODE == DISPLAY_MODE_TEXT)
+        /* The binary frames carry the count */
+        if (LOG_getDropped() != ui32LogDropped) {
+            ui32LogDropped = LOG_getDropped();
+            LOG1(LOG_MSG_LOG_DROPPED, ui32LogDropped);
         }
-        vTaskDelayUntil( &xLastWakeTime, pdMS_TO_TICKS( 100 ) );
+#endif
     }
 }
 
-/* Task to get current temperature of Seat 2 */
-void vSeat2AdjustHeaterTask(void *pvParameters)
+#if UART0_TX_BENCHMARK
+
+#define UART0_BENCHMARK_POLLED      0
+#define UART0_BENCHMARK_INTERRUPT   1
+#define UART0_BENCHMARK_DMA         2
+#define UART0_BENCHMARK_MODES       3
+
+static const LOG_MessageType pxUart0BenchmarkMessages[UART0_BENCHMARK_MODES] = {
+    LOG_MSG_UART_BENCH_POLLED, LOG_MSG_UART_BENCH_INTERRUPT, LOG_MSG_UART_BENCH_DMA
+};
+
+/* NUL terminated so the interrupt mode can send it with UART0_SendString() */
+static uint8 pui8Uart0BenchmarkReport[UART0_BENCHMARK_REPORT_SIZE + 1];
+static volatile uint32 ui32Uart0BenchmarkSpins;
+static volatile boolean bUart0BenchmarkDmaDone;
+
+/* uDMA completion, from the UART0 interrupt */
+static void vUart0BenchmarkDmaDone(void)
 {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-    SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
-    uint8_t ui8seat2DesiredTempValueC;
-    uint8_t ui8seat2CurrentTempValueC;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    for (;;) {
-        switch (systemState->Seat2heatingLevel) {
-        case HEATING_LOW:
-            ui8seat2DesiredTempValueC = 25;
-            break;
-        case HEATING_MEDIUM:
-            ui8seat2DesiredTempValueC = 30;
-            break;
-        case HEATING_HIGH:
-            ui8seat2DesiredTempValueC = 35;
-            break;
-        default:
-            break;
+    bUart0BenchmarkDmaDone = TRUE;
+    vTaskNotifyGiveFromISR(vUart0BenchmarkTaskHandle, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Send the report in one mode, returns the time until the last stop bit in usec */
+static uint32 ui32Uart0BenchmarkRun(uint8 ui8Mode)
+{
+    uint32 ui32Start = GPTM_WTimer1Read();
+
+    switch (ui8Mode) {
+    case UART0_BENCHMARK_POLLED:
+        UART0_SendBufferPolled(pui8Uart0BenchmarkReport, UART0_BENCHMARK_REPORT_SIZE);
+        while (!UART0_IsTxIdle());
+        break;
+    case UART0_BENCHMARK_INTERRUPT:
+        UART0_SendString(pui8Uart0BenchmarkReport);
+        while (!UART0_IsTxIdle()) {
+            vTaskDelay(pdMS_TO_TICKS(10));
         }
-        ui8seat2CurrentTempValueC = systemState->ui8Seat2TempValueC;
-
-
-        if(ui8seat2CurrentTempValueC <= 40 && ui8seat2CurrentTempValueC >= 5){
-
-            if((ui8seat2DesiredTempValueC > ui8seat2CurrentTempValueC) && ((systemState->Seat2heatingLevel) != HEATING_OFF)){
-
-                if((ui8seat2DesiredTempValueC - ui8seat2CurrentTempValueC) >= 10){
-                    systemState->Seat2heaterState = HEATER_HIGH;
-
-                    GPIO_RedLedOff();
-                    GPIO_GreenLedOn();
-                    GPIO_BlueLedOff();
-
-                }
-                else if((ui8seat2DesiredTempValueC - ui8seat2CurrentTempValueC) >= 5){
-                    systemState->Seat2heaterState = HEATER_MEDIUM;
-                    GPIO_RedLedOff();
-                    GPIO_GreenLedOff();
-                    GPIO_BlueLedOn();
-                }
-                else if(
-                        (((ui8seat2DesiredTempValueC - ui8seat2CurrentTempValueC) >= 2) && (systemState->Seat2heaterState != HEATER_OFF)) ||
-                        (((ui8seat2DesiredTempValueC - ui8seat2CurrentTempValueC) > 3) && (systemState->Seat2heaterState == HEATER_OFF))
-                )
-                {
-                    systemState->Seat2heaterState = HEATER_LOW;
-                    GPIO_RedLedOff();
-                    GPIO_GreenLedOn();
-                    GPIO_BlueLedOn();
-                }
-                else{
-                    systemState->Seat2heaterState = HEATER_OFF;
-                    GPIO_GreenLedOff();
-                    GPIO_BlueLedOff();
-                }
-            }
-            else{
-                systemState->Seat2heaterState = HEATER_OFF;
-                GPIO_RedLedOff();
-                GPIO_GreenLedOff();
-                GPIO_BlueLedOff();
-            }
+        break;
+    default:
+        bUart0BenchmarkDmaDone = FALSE;
+        UART0_SendBufferDMA(pui8Uart0BenchmarkReport, UART0_BENCHMARK_REPORT_SIZE, vUart0BenchmarkDmaDone);
+        while (!bUart0BenchmarkDmaDone) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
         }
-        else{
-            systemState->Seat2heaterState = HEATER_OFF;
-            GPIO_RedLedOn();
-            GPIO_GreenLedOff();
-            GPIO_BlueLedOff();
+        while (!UART0_IsTxIdle()) {
+            vTaskDelay(pdMS_TO_TICKS(10));
         }
-        vTaskDelayUntil( &xLastWakeTime, pdMS_TO_TICKS( 100 ) );
+        break;
     }
+    return GPTM_WTimer1Read() - ui32Start;
 }
 
-/* Task to check and change heating level for Seat 1 */
-void vCheckSeat1HeatingLevelChange(void *pvParameters)
+/* Lowest priority busy loop, its progress is the CPU time left over by the transmission */
+void vUart0BenchmarkSpinTask(void *pvParameters)
 {
-    SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
-    HeatingLevelType seat1CurrentHeatingLevel;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-
     for (;;) {
-
-        seat1CurrentHeatingLevel = systemState->Seat1heatingLevel;
-
-        if((GPIO_EXTSWGetState() == PRESSED) || (GPIO_SW1GetState() == PRESSED)){
-            vTaskDelay(pdMS_TO_TICKS(30));
-            if((GPIO_EXTSWGetState() == PRESSED) || (GPIO_SW1GetState() == PRESSED)){
-
-                switch (seat1CurrentHeatingLevel) {
-                case HEATING_OFF:
-                    systemState->Seat1heatingLevel = HEATING_LOW;
-                    break;
-                case HEATING_LOW:
-                    systemState->Seat1heatingLevel = HEATING_MEDIUM;
-                    break;
-                case HEATING_MEDIUM:
-                    systemState->Seat1heatingLevel = HEATING_HIGH;
-                    break;
-                case HEATING_HIGH:
-                    systemState->Seat1heatingLevel = HEATING_OFF;
-                    break;
-                default:
-                    break;
-                }
-                vTaskDelay(pdMS_TO_TICKS(500));
-            }
-        }
-        vTaskDelayUntil( &xLastWakeTime, pdMS_TO_TICKS( 100 ) );
-
+        ui32Uart0BenchmarkSpins++;
     }
 }
 
-/* Task to check and change heating level for Seat 2 */
-void vCheckSeat2HeatingLevelChange(void *pvParameters)
+/* One shot comparison of the UART0 transmit modes, see UART0_TX_BENCHMARK */
+void vUart0BenchmarkTask(void *pvParameters)
 {
-    SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
-    HeatingLevelType seat2currentHeatingLevel;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint32 pui32TimeUs[UART0_BENCHMARK_MODES];
+    uint32 pui32Spins[UART0_BENCHMARK_MODES];
+    uint32 ui32BaselineSpins;
+    uint32 ui32BaselineUs;
+    uint32 ui32Start;
+    uint32 ui32Index;
+    uint8 ui8Mode;
+
+    /* Printable lines of a timing table */
+    for (ui32Index = 0; ui32Index < UART0_BENCHMARK_REPORT_SIZE; ui32Index++) {
+        pui8Uart0BenchmarkReport[ui32Index] = ((ui32Index % 64) == 63) ? '\n' : (uint8)('0' + (ui32Index % 10));
+    }
+    pui8Uart0BenchmarkReport[UART0_BENCHMARK_REPORT_SIZE] = '\0';
 
-    for (;;) {
+    vTaskDelay(pdMS_TO_TICKS(3000));
 
-        seat2currentHeatingLevel = systemState->Seat2heatingLevel;
-
-        if(GPIO_SW2GetState() == PRESSED){
-            vTaskDelay(pdMS_TO_TICKS(30));
-            if(GPIO_SW2GetState() == PRESSED){
-
-                switch (seat2currentHeatingLevel) {
-                case HEATING_OFF:
-                    systemState->Seat2heatingLevel = HEATING_LOW;
-                    break;
-                case HEATING_LOW:
-                    systemState->Seat2heatingLevel = HEATING_MEDIUM;
-                    break;
-                case HEATING_MEDIUM:
-                    systemState->Seat2heatingLevel = HEATING_HIGH;
-                    break;
-                case HEATING_HIGH:
-                    systemState->Seat2heatingLevel = HEATING_OFF;
-                    break;
-                default:
-                    break;
-                }
-                vTaskDelay(pdMS_TO_TICKS(500));
-            }
+    if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
+        while (!UART0_IsTxIdle()) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+
+        /* Spin rate with the transmitter idle */
+        ui32Start = GPTM_WTimer1Read();
+        ui32BaselineSpins = ui32Uart0BenchmarkSpins;
+        vTaskDelay(pdMS_TO_TICKS(UART0_BENCHMARK_BASELINE_MS));
+        ui32BaselineSpins = ui32Uart0BenchmarkSpins - ui32BaselineSpins;
+        ui32BaselineUs = GPTM_WTimer1Read() - ui32Start;
+
+        for (ui8Mode = 0; ui8Mode < UART0_BENCHMARK_MODES; ui8Mode++) {
+            pui32Spins[ui8Mode] = ui32Uart0BenchmarkSpins;
+            pui32TimeUs[ui8Mode] = ui32Uart0BenchmarkRun(ui8Mode);
+            pui32Spins[ui8Mode] = ui32Uart0BenchmarkSpins - pui32Spins[ui8Mode];
         }
-        vTaskDelayUntil( &xLastWakeTime, pdMS_TO_TICKS( 100 ) );
+        vTaskDelete(vUart0BenchmarkSpinTaskHandle);
+
+        xSemaphoreGive(xMutex);
 
+        LOG1(LOG_MSG_UART_BENCH_SIZE, UART0_BENCHMARK_REPORT_SIZE);
+        for (ui8Mode = 0; ui8Mode < UART0_BENCHMARK_MODES; ui8Mode++) {
+            /* CPU share: spins missing compared to the idle rate over the same time */
+            uint64 ui64Expected = ((uint64)ui32BaselineSpins * pui32TimeUs[ui8Mode]) / ui32BaselineUs;
+            sint64 i64CpuPercent = 100 - (sint64)(((uint64)pui32Spins[ui8Mode] * 100) / ui64Expected);
+
+            LOG2(pxUart0BenchmarkMessages[ui8Mode],
+                 ((uint64)UART0_BENCHMARK_REPORT_SIZE * 1000000) / pui32TimeUs[ui8Mode], (sint32)i64CpuPercent);
+        }
     }
+    vTaskDelete(NULL);
 }
 
+#endif /* UART0_TX_BENCHMARK */
+
 /*-----------------------------------------------------------*/
@@ -0,0 +1,205 @@
+/*
+ * fmt_bench.cpp
+ *
+ * Host check and benchmark of the decimal formatting of Project/Common/fmt.c against the
+ * former UART0_SendInteger() conversion (64-bit, one % and one / per digit) and snprintf.
+ * The formatter is compiled from the unchanged target sources:
+ *
+ *     gcc -O2 -I../Project/Common -c ../Project/Common/fmt.c -o fmt.o
+ *     g++ -O2 -std=c++17 -I../Project/Common fmt_bench.cpp fmt.o -o fmt_bench
+ *     ./fmt_bench [iterations]
+ *
+ * Every function is first compared with snprintf (integers) or with an exact 64-bit
+ * reference (Q-format) on the limits of the ranges and on random values, a mismatch
+ * fails the run. The timings only give the relative cost: the host divides 64-bit values
+ * in hardware, the Cortex-M4 calls the library division for them, so the gap on the
+ * target is larger than reported here.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "fmt.h"
+}
+
+namespace {
+
+const uint32_t kPowers10[] = { 1, 10, 100, 1000, 10000 };
+
+uint32_t g_ui32Seed = 12345;
+
+uint32_t nextRandom()
+{
+    g_ui32Seed = g_ui32Seed * 1664525u + 1013904223u;
+    return g_ui32Seed;
+}
+
+/* Random value with a random number of significant bits, so every digit count shows up */
+int32_t randomValue()
+{
+    uint32_t ui32Value = nextRandom() >> (nextRandom() % 32);
+    return (nextRandom() & 1) ? -(int32_t)(ui32Value >> 1) : (int32_t)ui32Value;
+}
+
+/* Conversion of UART0_SendInteger() before Common/fmt.c, into a buffer instead of the UART */
+uint32_t legacyInteger(uint8_t *pui8Out, int64_t i64Number)
+{
+    uint8_t pui8Digits[21];
+    int8_t i8Counter = sizeof(pui8Digits);
+    bool bNegative = false;
+
+    if (i64Number < 0) {
+        bNegative = true;
+        i64Number *= -1;
+    }
+    do {
+        pui8Digits[--i8Counter] = i64Number % 10 + '0';
+        i64Number /= 10;
+    } while (i64Number != 0);
+    if (bNegative) {
+        pui8Digits[--i8Counter] = '-';
+    }
+    std::memcpy(pui8Out, &pui8Digits[i8Counter], sizeof(pui8Digits) - i8Counter);
+    return sizeof(pui8Digits) - i8Counter;
+}
+
+uint32_t snprintfInteger(uint8_t *pui8Out, int32_t i32Value)
+{
+    return (uint32_t)std::snprintf((char *)pui8Out, FMT_S32_MAX_SIZE + 1, "%" PRId32, i32Value);
+}
+
+/* Exact Q-format text: magnitude times 10^decimals rounded half away from zero in 64 bits */
+std::string referenceQ(int32_t i32Value, unsigned uFracBits, unsigned uDecimals)
+{
+    uint64_t ui64Magnitude = (i32Value < 0) ? (uint64_t)(-(int64_t)i32Value) : (uint64_t)i32Value;
+    uint64_t ui64Scaled = ui64Magnitude * kPowers10[uDecimals];
+    if (uFracBits != 0) {
+        ui64Scaled = (ui64Scaled + (1ULL << (uFracBits - 1))) >> uFracBits;
+    }
+    char pcText[32];
+    int iLength = std::snprintf(pcText, sizeof(pcText), "%s%" PRIu64, ((i32Value < 0) && (ui64Scaled != 0)) ? "-" : "",
+                                ui64Scaled / kPowers10[uDecimals]);
+    if (uDecimals != 0) {
+        std::snprintf(pcText + iLength, sizeof(pcText) - iLength, ".%0*" PRIu64, (int)uDecimals,
+                      ui64Scaled % kPowers10[uDecimals]);
+    }
+    return pcText;
+}
+
+bool expect(const char *pcWhat, int64_t i64Value, const uint8_t *pui8Text, uint32_t ui32Length, const std::string &xExpected)
+{
+    if (std::string((const char *)pui8Text, ui32Length) == xExpected) {
+        return true;
+    }
+    std::fprintf(stderr, "%s(%" PRId64 "): \"%.*s\" instead of \"%s\"\n", pcWhat, i64Value, (int)ui32Length,
+                 (const char *)pui8Text, xExpected.c_str());
+    return false;
+}
+
+bool check()
+{
+    std::vector<int32_t> xValues = { 0, 1, -1, 9, 10, 99, 100, -100, 999, 1000, 65535, 99999999, 100000000,
+                                     999999999, 1000000000, INT32_MAX, INT32_MIN, INT32_MIN + 1 };
+    for (int iIndex = 0; iIndex < 200000; iIndex++) {
+        xValues.push_back(randomValue());
+    }
+
+    uint8_t pui8Text[FMT_Q32_MAX_SIZE + 1];
+    char pcExpected[32];
+    unsigned long ulChecks = 0;
+    bool bOk = true;
+
+    for (int32_t i32Value : xValues) {
+        uint32_t ui32Value = (uint32_t)i32Value;
+
+        std::snprintf(pcExpected, sizeof(pcExpected), "%" PRId32, i32Value);
+        bOk &= expect("FMT_s32", i32Value, pui8Text, FMT_s32(pui8Text, i32Value), pcExpected);
+        std::snprintf(pcExpected, sizeof(pcExpected), "%" PRIu32, ui32Value);
+        bOk &= expect("FMT_u32", ui32Value, pui8Text, FMT_u32(pui8Text, ui32Value), pcExpected);
+        std::snprintf(pcExpected, sizeof(pcExpected), "%" PRIx32, ui32Value);
+        bOk &= expect("FMT_x32", ui32Value, pui8Text, FMT_x32(pui8Text, ui32Value), pcExpected);
+        std::snprintf(pcExpected, sizeof(pcExpected), "%5" PRIu32, ui32Value);
+        bOk &= expect("FMT_u32Pad ' '", ui32Value, pui8Text, FMT_u32Pad(pui8Text, ui32Value, 5, ' '), pcExpected);
+        std::snprintf(pcExpected, sizeof(pcExpected), "%03" PRIu32, ui32Value);
+        bOk &= expect("FMT_u32Pad '0'", ui32Value, pui8Text, FMT_u32Pad(pui8Text, ui32Value, 3, '0'), pcExpected);
+        ulChecks += 5;
+
+        for (unsigned uFracBits = 0; uFracBits <= FMT_Q_MAX_FRAC_BITS; uFracBits++) {
+            for (unsigned uDecimals = 0; uDecimals <= FMT_Q_MAX_DECIMALS; uDecimals++) {
+                bOk &= expect("FMT_q32", i32Value, pui8Text, FMT_q32(pui8Text, i32Value, uFracBits, uDecimals),
+                              referenceQ(i32Value, uFracBits, uDecimals));
+                ulChecks++;
+            }
+        }
+        if (!bOk) {
+            return false;
+        }
+    }
+    std::printf("%lu conversions match the references\n", ulChecks);
+    return true;
+}
+
+template <typename Format>
+void bench(const char *pcName, const std::vector<int32_t> &xValues, uint32_t ui32Iterations, Format fFormat)
+{
+    uint8_t pui8Text[32];
+    uint32_t ui32Checksum = 0;
+    uint64_t ui64Bytes = 0;
+
+    auto xStart = std::chrono::steady_clock::now();
+    for (uint32_t ui32Iteration = 0; ui32Iteration < ui32Iterations; ui32Iteration++) {
+        for (int32_t i32Value : xValues) {
+            uint32_t ui32Length = fFormat(pui8Text, i32Value);
+            ui32Checksum = ui32Checksum * 31 + pui8Text[ui32Length - 1];
+            ui64Bytes += ui32Length;
+        }
+    }
+    auto xElapsed = std::chrono::steady_clock::now() - xStart;
+    double dNanoseconds = std::chrono::duration<double, std::nano>(xElapsed).count();
+    uint64_t ui64Conversions = (uint64_t)ui32Iterations * xValues.size();
+
+    std::printf("%-28s %7.2f ns/value %7.2f ns/byte (checksum %08" PRIx32 ")\n", pcName,
+                dNanoseconds / ui64Conversions, dNanoseconds / ui64Bytes, ui32Checksum);
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    uint32_t ui32Iterations = (argc > 1) ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 200;
+
+    if (!check()) {
+        return 1;
+    }
+
+    /* Status screen values (temperatures, currents, times) and the full 32-bit range */
+    std::vector<int32_t> xSmall(4096), xFull(4096);
+    for (size_t uIndex = 0; uIndex < xSmall.size(); uIndex++) {
+        xSmall[uIndex] = (int32_t)(nextRandom() % 5000);
+        xFull[uIndex] = randomValue();
+    }
+
+    const struct {
+        const char *pcName;
+        const std::vector<int32_t> &xValues;
+    } kSets[] = { { "0 .. 4999", xSmall }, { "full range", xFull } };
+
+    for (const auto &sSet : kSets) {
+        std::printf("\nvalues %s, %u x %zu conversions\n", sSet.pcName, ui32Iterations, sSet.xValues.size());
+        bench("former UART0_SendInteger", sSet.xValues, ui32Iterations,
+              [](uint8_t *pui8Out, int32_t i32Value) { return legacyInteger(pui8Out, i32Value); });
+        bench("snprintf", sSet.xValues, ui32Iterations, snprintfInteger);
+        bench("FMT_s32", sSet.xValues, ui32Iterations,
+              [](uint8_t *pui8Out, int32_t i32Value) { return (uint32_t)FMT_s32(pui8Out, i32Value); });
+        bench("FMT_q32 Q8, 1 decimal", sSet.xValues, ui32Iterations,
+              [](uint8_t *pui8Out, int32_t i32Value) { return (uint32_t)FMT_q32(pui8Out, i32Value, 8, 1); });
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""
+gen_pots_lut.py
+
+Generates HAL/POTS/pots_lut_table.h, the raw ADC code to temperature tables used
+by POTS_lutToTempQ8(). Run it again whenever the sensor parameters or the table
+resolution change:
+
+    python3 gen_pots_lut.py --bits 6 --output ../Project/HAL/POTS/pots_lut_table.h
+
+Two sensor models are emitted:
+  * POT : the potentiometers of the development board, 0 .. 45 C linear over the
+          full ADC range (the original "raw * 45 / 4096" conversion).
+  * NTC : a Beta-model thermistor on the low side of a divider with a fixed pull-up,
+          raw = 4096 * Rntc / (Rntc + Rpullup).
+
+The table holds 2^bits + 1 points in Q8 C, evenly spaced 2^(12 - bits) codes apart,
+so the target interpolates with a shift instead of a division. After generation
+every one of the 4096 codes is interpolated exactly as the target does it and
+compared with the analytic model; the script fails if the worst error exceeds
+--max-error.
+"""
+
+import argparse
+import math
+import sys
+
+ADC_BITS = 12
+ADC_CODES = 1 << ADC_BITS
+Q8_ONE = 256
+INT16_MIN = -32768
+INT16_MAX = 32767
+
+
+def pot_model(raw, args):
+    return raw * 45.0 / ADC_CODES
+
+
+def ntc_model(raw, args):
+    if raw <= 0:
+        return args.t_max
+    if raw >= ADC_CODES:
+        return args.t_min
+    r_ntc = args.r_pullup * raw / (ADC_CODES - raw)
+    t25 = 298.15
+    inv_t = (1.0 / t25) + math.log(r_ntc / args.r25) / args.beta
+    return min(max((1.0 / inv_t) - 273.15, args.t_min), args.t_max)
+
+
+def to_q8(celsius):
+    return max(INT16_MIN, min(INT16_MAX, int(round(celsius * Q8_ONE))))
+
+
+def build_table(model, args):
+    # The last point sits one code past the ADC range so the top segment is as wide as the others
+    shift = ADC_BITS - args.bits
+    return [to_q8(model(i << shift, args)) for i in range((1 << args.bits) + 1)]
+
+
+def interpolate(table, raw, shift):
+    """Bit exact copy of POTS_lutToTempQ8()."""
+    index = raw >> shift
+    frac = raw & ((1 << shift) - 1)
+    return table[index] + (((table[index + 1] - table[index]) * frac) >> shift)
+
+
+def worst_error(table, model, in_range, args):
+    """Worst interpolation error over the codes whose model temperature is in range."""
+    shift = ADC_BITS - args.bits
+    worst = (0.0, 0)
+    for raw in range(ADC_CODES):
+        expected = model(raw, args)
+        if not in_range(expected):
+            continue
+        error = abs(interpolate(table, raw, shift) / Q8_ONE - expected)
+        if error > worst[0]:
+            worst = (error, raw)
+    return worst
+
+
+def emit_table(name, table):
+    lines = []
+    for start in range(0, len(table), 8):
+        chunk = ", ".join("%6d" % value for value in table[start:start + 8])
+        lines.append("    " + chunk + ",")
+    lines[-1] = lines[-1].rstrip(",")
+    return "static const int16_t %s[POTS_LUT_POINTS] = {\n%s\n};\n" % (name, "\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--bits", type=int, default=6, help="log2 of the number of table segments")
+    parser.add_argument("--r25", type=float, default=10000.0, help="NTC resistance at 25 C")
+    parser.add_argument("--beta", type=float, default=3950.0, help="NTC Beta coefficient")
+    parser.add_argument("--r-pullup", type=float, default=10000.0, help="divider pull-up resistance")
+    parser.add_argument("--t-min", type=float, default=-40.0, help="lowest temperature in the table")
+    parser.add_argument("--t-max", type=float, default=125.0, help="highest temperature in the table")
+    parser.add_argument("--max-error", type=float, default=0.5, help="allowed interpolation error in C")
+    parser.add_argument("--ntc-check-range", type=float, nargs=2, default=(-20.0, 100.0),
+                        help="temperature range over which the NTC error is checked")
+    parser.add_argument("--output", default="pots_lut_table.h")
+    args = parser.parse_args()
+
+    if not 1 <= args.bits <= ADC_BITS:
+        parser.error("--bits must be between 1 and %d" % ADC_BITS)
+
+    pot_table = build_table(pot_model, args)
+    ntc_table = build_table(ntc_model, args)
+
+    # The NTC curve is only checked where the sensor is meant to be used, outside of it
+    # the table is clamped to --t-min/--t-max anyway.
+    low, high = args.ntc_check_range
+
+    failed = False
+    for name, table, model, in_range in (("POT", pot_table, pot_model, lambda t: True),
+                                         ("NTC", ntc_table, ntc_model, lambda t: low <= t <= high)):
+        worst = worst_error(table, model, in_range, args)
+        print("%s: %d points, worst error %.3f C at raw %d" % (name, len(table), worst[0], worst[1]))
+        if worst[0] > args.max_error:
+            failed = True
+
+    if failed:
+        print("error: interpolation error above %.3f C, increase --bits" % args.max_error, file=sys.stderr)
+        return 1
+
+    with open(args.output, "w", newline="\n") as header:
+        header.write("""/*
+ * pots_lut_table.h
+ *
+ *  Generated by Tools/gen_pots_lut.py, do not edit by hand.
+ *  --bits %d --r25 %g --beta %g --r-pullup %g --t-min %g --t-max %g
+ */
+
+#ifndef HAL_POTS_POTS_LUT_TABLE_H_
+#define HAL_POTS_POTS_LUT_TABLE_H_
+
+#include <stdint.h>
+
+#define POTS_LUT_SEGMENT_SHIFT  %d
+#define POTS_LUT_POINTS         %d
+
+/* Temperature in Q8 C at raw = index << POTS_LUT_SEGMENT_SHIFT */
+%s
+%s
+#endif /* HAL_POTS_POTS_LUT_TABLE_H_ */
+""" % (args.bits, args.r25, args.beta, args.r_pullup, args.t_min, args.t_max,
+       ADC_BITS - args.bits, len(pot_table),
+       emit_table("pi16PotsLutPotTable", pot_table),
+       emit_table("pi16PotsLutNtcTable", ntc_table)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
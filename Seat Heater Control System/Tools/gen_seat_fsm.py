@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+gen_seat_fsm.py
+
+Generates APP/SEAT/seat_fsm_table.h, the heater state machine used by the seats in
+SEAT_CONTROL_THRESHOLD mode. Thresholds, hysteresis and indicator patterns are declared
+once in RULES below; run the script again after changing them:
+
+    python3 gen_seat_fsm.py --output ../Project/APP/SEAT/seat_fsm_table.h
+
+The error between the desired and the current temperature (whole C) is saturated to
+0 .. highest threshold and used, together with the current heater state, as the index of
+a byte table. Each byte holds the next heater state and the LEDs to turn on and off, so
+SEAT_fsmStep() needs no comparison chain. Error 0 means no demand: setpoint reached or
+heating level OFF.
+
+Tools/seat_fsm_check.c verifies the generated table against the original if/else chain
+for every state, level and temperature.
+"""
+
+import argparse
+import sys
+
+# Heater states, in HeaterStateType order
+STATES = ["HEATER_OFF", "HEATER_LOW", "HEATER_MEDIUM", "HEATER_HIGH"]
+
+# SEAT_LED_* bits of seat.h
+LED_RED = 0x1
+LED_GREEN = 0x2
+LED_BLUE = 0x4
+LED_ALL = LED_RED | LED_GREEN | LED_BLUE
+
+# Heating rules, checked from the top, the first one whose threshold is reached wins.
+# "enter" is the error in C needed while the heater is off, "hold" while it is on.
+RULES = [
+    # state            enter  hold   LEDs on                LEDs off
+    ("HEATER_HIGH",      10,   10,   LED_GREEN,             LED_RED | LED_BLUE),
+    ("HEATER_MEDIUM",     5,    5,   LED_BLUE,              LED_RED | LED_GREEN),
+    ("HEATER_LOW",        4,    2,   LED_GREEN | LED_BLUE,  LED_RED),
+]
+
+# Below the setpoint but inside the hysteresis band: heater off, red LED left as it is
+IN_BAND = ("HEATER_OFF", 0, LED_GREEN | LED_BLUE)
+
+# No demand: heater off and all LEDs off
+NO_DEMAND = ("HEATER_OFF", 0, LED_ALL)
+
+STATE_BITS = 2
+LEDS_ON_SHIFT = STATE_BITS
+LEDS_OFF_SHIFT = STATE_BITS + 3
+
+
+def pack(state, leds_on, leds_off):
+    return STATES.index(state) | (leds_on << LEDS_ON_SHIFT) | (leds_off << LEDS_OFF_SHIFT)
+
+
+def decide(state, error):
+    """Next state and LED pattern for a heater in `state` with `error` C of demand."""
+    if error <= 0:
+        return NO_DEMAND
+    heating = state != "HEATER_OFF"
+    for next_state, enter, hold, leds_on, leds_off in RULES:
+        if error >= (hold if heating else enter):
+            return next_state, leds_on, leds_off
+    return IN_BAND
+
+
+def build_table():
+    bands = max(max(enter, hold) for _, enter, hold, _, _ in RULES) + 1
+    return bands, [[pack(*decide(state, error)) for error in range(bands)] for state in STATES]
+
+
+def emit_table(bands, table):
+    rows = []
+    for state, row in zip(STATES, table):
+        values = ", ".join("0x%02X" % value for value in row)
+        rows.append("    { %s },   /* %s */" % (values, state))
+    rows[-1] = rows[-1].replace("},", "} ", 1)
+    return "static const uint8 pui8SeatFsmTable[%d][SEAT_FSM_ERROR_BANDS] = {\n%s\n};\n" % (
+        len(STATES), "\n".join(rows))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--output", default="seat_fsm_table.h")
+    args = parser.parse_args()
+
+    for state, enter, hold, _, _ in RULES:
+        if hold > enter:
+            print("error: %s holds at %d C but enters at %d C" % (state, hold, enter), file=sys.stderr)
+            return 1
+
+    bands, table = build_table()
+    print("%d states x %d error bands" % (len(STATES), bands))
+
+    with open(args.output, "w", newline="\n") as header:
+        header.write("""/*
+ * seat_fsm_table.h
+ *
+ *  Generated by Tools/gen_seat_fsm.py, do not edit by hand.
+ */
+
+#ifndef APP_SEAT_SEAT_FSM_TABLE_H_
+#define APP_SEAT_SEAT_FSM_TABLE_H_
+
+#include "std_types.h"
+
+/* Error bands: 0 --> no demand, n --> n C below the setpoint, the last band also
+ * holds every larger error */
+#define SEAT_FSM_ERROR_BANDS        %d
+
+/* Entry layout: next HeaterStateType | LEDs to turn on | LEDs to turn off (SEAT_LED_* masks) */
+#define SEAT_FSM_STATE_MASK         0x%02X
+#define SEAT_FSM_LEDS_ON_SHIFT      %d
+#define SEAT_FSM_LEDS_OFF_SHIFT     %d
+#define SEAT_FSM_LEDS_MASK          0x%02X
+
+/* Indexed by [current heater state][error band] */
+%s
+#endif /* APP_SEAT_SEAT_FSM_TABLE_H_ */
+""" % (bands, (1 << STATE_BITS) - 1, LEDS_ON_SHIFT, LEDS_OFF_SHIFT, LED_ALL, emit_table(bands, table)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
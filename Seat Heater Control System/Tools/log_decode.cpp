@@ -0,0 +1,199 @@
+/*
+ * log_decode.cpp
+ *
+ * Host decoder of the deferred log (Project/APP/LOG/log.h). The target only sends message
+ * IDs, timestamps and raw arguments in TELEMETRY_RECORD_LOG frames, the text is rebuilt
+ * here from the string table of Project/APP/LOG/log_messages.h with the formatter of the
+ * target. Reads a raw capture of the UART, for example `cat /dev/ttyACM0 > capture.bin`,
+ * the status records of the same stream are skipped. Build from the unchanged target
+ * sources:
+ *
+ *     P=../Project
+ *     gcc -O2 -c -I$P -I$P/Common $P/Common/cobs.c $P/Common/crc16.c $P/Common/fmt.c $P/APP/LOG/log_format.c
+ *     g++ -O2 -std=c++17 -I$P -I$P/Common log_decode.cpp cobs.o crc16.o fmt.o log_format.o -o log_decode
+ *     ./log_decode [--list] [capture.bin]      (stdin without a file)
+ *
+ * --list prints the string table with the ID of every message instead. Decode a capture
+ * with the log_messages.h of the firmware that produced it: a record only carries the
+ * index of its message. Records dropped by the target and lost frames are reported inline
+ * and counted on stderr.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "APP/LOG/log.h"
+#include "APP/TELEMETRY/telemetry.h"
+#include "crc16.h"
+}
+
+namespace {
+
+struct Counters {
+    unsigned long ulRecords = 0;
+    unsigned long ulFrames = 0;
+    unsigned long ulOtherFrames = 0;    /* status records, text, cut frames */
+    unsigned long ulBadCrc = 0;
+    unsigned long ulBadLayout = 0;
+    unsigned long ulFrameGaps = 0;
+    unsigned long ulDropped = 0;        /* on the target, as reported by the frames */
+};
+
+uint32_t get32(const uint8_t *pui8In)
+{
+    return (uint32_t)pui8In[0] | ((uint32_t)pui8In[1] << 8) | ((uint32_t)pui8In[2] << 16) |
+           ((uint32_t)pui8In[3] << 24);
+}
+
+void listMessages()
+{
+    for (uint32_t ui32Id = 0; ui32Id < LOG_MSG_COUNT; ui32Id++) {
+        std::printf("%3lu  %s\n", (unsigned long)ui32Id, LOG_getFormat(ui32Id));
+    }
+}
+
+class Decoder {
+public:
+    void feed(uint8_t ui8Byte)
+    {
+        if (ui8Byte != COBS_DELIMITER) {
+            m_xFrame.push_back(ui8Byte);
+            return;
+        }
+        if (!m_xFrame.empty()) {
+            frame();
+            m_xFrame.clear();
+        }
+    }
+
+    const Counters &counters() const { return m_sCounters; }
+
+private:
+    void frame()
+    {
+        std::vector<uint8_t> xRecord(m_xFrame.size());
+        uint32 ui32Length = COBS_decode(m_xFrame.data(), (uint32)m_xFrame.size(), xRecord.data());
+
+        if ((ui32Length < LOG_FRAME_HEADER_SIZE + LOG_FRAME_CRC_SIZE) || (xRecord[0] != TELEMETRY_VERSION) ||
+            (xRecord[1] != TELEMETRY_RECORD_LOG)) {
+            m_sCounters.ulOtherFrames++;
+            return;
+        }
+        ui32Length -= LOG_FRAME_CRC_SIZE;
+        if (CRC16_update(CRC16_INIT, xRecord.data(), ui32Length) !=
+            (xRecord[ui32Length] | (xRecord[ui32Length + 1] << 8))) {
+            m_sCounters.ulBadCrc++;
+            return;
+        }
+
+        unsigned uSequence = xRecord[2] | (xRecord[3] << 8);
+        uint32_t ui32Dropped = get32(&xRecord[4]);
+        if (m_bSeen && (uSequence != ((m_uLastSequence + 1) & 0xFFFF))) {
+            std::printf("-- %u log frames lost --\n", (uSequence - m_uLastSequence - 1) & 0xFFFF);
+            m_sCounters.ulFrameGaps++;
+        }
+        if (ui32Dropped != m_ui32Dropped) {
+            if (m_bSeen) {
+                std::printf("-- %lu log records dropped on the target --\n", (unsigned long)(ui32Dropped - m_ui32Dropped));
+            }
+            m_sCounters.ulDropped = ui32Dropped;
+            m_ui32Dropped = ui32Dropped;
+        }
+        m_bSeen = true;
+        m_uLastSequence = uSequence;
+        m_sCounters.ulFrames++;
+
+        for (uint32 ui32Offset = LOG_FRAME_HEADER_SIZE; ui32Offset < ui32Length;) {
+            if (ui32Length - ui32Offset < 4 * LOG_RECORD_WORDS(0)) {
+                m_sCounters.ulBadLayout++;
+                return;
+            }
+            uint32_t ui32Header = get32(&xRecord[ui32Offset]);
+            uint32_t ui32Args = (ui32Header & LOG_HEADER_ARGS_MASK) >> LOG_HEADER_ARGS_SHIFT;
+            if (ui32Length - ui32Offset < 4 * LOG_RECORD_WORDS(ui32Args)) {
+                m_sCounters.ulBadLayout++;
+                return;
+            }
+            uint32 pui32Args[8];
+            for (uint32_t ui32Arg = 0; ui32Arg < ui32Args; ui32Arg++) {
+                pui32Args[ui32Arg] = get32(&xRecord[ui32Offset + 8 + 4 * ui32Arg]);
+            }
+            print(ui32Header & LOG_HEADER_ID_MASK, get32(&xRecord[ui32Offset + 4]), pui32Args, ui32Args);
+            ui32Offset += 4 * LOG_RECORD_WORDS(ui32Args);
+        }
+    }
+
+    void print(uint32_t ui32Id, uint32_t ui32Timestamp, const uint32 *pui32Args, uint32_t ui32Args)
+    {
+        uint8 pui8Text[256];
+        const char *pcFormat = LOG_getFormat(ui32Id);
+        uint32 ui32Length;
+
+        /* The usec counter wraps every 71 minutes, records of interrupts may come slightly
+         * out of order: the nearest unwrapped time wins */
+        if (m_sCounters.ulRecords == 0) {
+            m_ui64TimeUs = ui32Timestamp;
+        }
+        m_ui64TimeUs += (int64_t)(int32_t)(ui32Timestamp - (uint32_t)m_ui64TimeUs);
+        if (pcFormat == nullptr) {
+            std::printf("[%llu.%06llu] unknown log message %lu\n", (unsigned long long)(m_ui64TimeUs / 1000000),
+                        (unsigned long long)(m_ui64TimeUs % 1000000), (unsigned long)ui32Id);
+        } else {
+            ui32Length = LOG_format(pcFormat, pui32Args, ui32Args, pui8Text, sizeof(pui8Text));
+            std::printf("[%llu.%06llu] %.*s\n", (unsigned long long)(m_ui64TimeUs / 1000000),
+                        (unsigned long long)(m_ui64TimeUs % 1000000), (int)ui32Length, (const char *)pui8Text);
+        }
+        m_sCounters.ulRecords++;
+    }
+
+    std::vector<uint8_t> m_xFrame;
+    bool m_bSeen = false;
+    unsigned m_uLastSequence = 0;
+    uint32_t m_ui32Dropped = 0;
+    uint64_t m_ui64TimeUs = 0;
+    Counters m_sCounters;
+};
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    const char *pcPath = nullptr;
+
+    for (int iArg = 1; iArg < argc; iArg++) {
+        if (std::strcmp(argv[iArg], "--list") == 0) {
+            listMessages();
+            return 0;
+        }
+        pcPath = argv[iArg];
+    }
+
+    FILE *pxIn = pcPath ? std::fopen(pcPath, "rb") : stdin;
+    if (pxIn == nullptr) {
+        std::perror(pcPath);
+        return 1;
+    }
+
+    Decoder xDecoder;
+    uint8_t pui8Buffer[4096];
+    size_t uRead;
+    while ((uRead = std::fread(pui8Buffer, 1, sizeof(pui8Buffer), pxIn)) > 0) {
+        for (size_t uIndex = 0; uIndex < uRead; uIndex++) {
+            xDecoder.feed(pui8Buffer[uIndex]);
+        }
+    }
+    if (pxIn != stdin) {
+        std::fclose(pxIn);
+    }
+
+    const Counters &sCounters = xDecoder.counters();
+    std::fprintf(stderr,
+                 "%lu records in %lu frames, %lu frames lost, %lu records dropped on the target, "
+                 "skipped: %lu other frames, %lu bad CRC, %lu bad layout\n",
+                 sCounters.ulRecords, sCounters.ulFrames, sCounters.ulFrameGaps, sCounters.ulDropped,
+                 sCounters.ulOtherFrames, sCounters.ulBadCrc, sCounters.ulBadLayout);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * pid_bench.cpp
+ *
+ * Host benchmark of PID_update() (Project/APP/PID/pid.c), the fixed-point seat heater
+ * controller. The controller is compiled from the unchanged target sources:
+ *
+ *     gcc -O2 -I../Project -I../Project/Common -c ../Project/APP/PID/pid.c -o pid.o
+ *     g++ -O2 -std=c++17 -I../Project -I../Project/Common pid_bench.cpp pid.o -o pid_bench
+ *     ./pid_bench [iterations]
+ *
+ * The controller closes the loop on a crude first-order seat model so that every
+ * iteration sees a different error and the saturation / anti-windup branches are
+ * exercised as on the target. The model update is timed separately and subtracted.
+ * On x86 the cost is also reported in TSC ticks; these are host cycles at the nominal
+ * TSC frequency and only give the relative cost, the Cortex-M4 figure has to be taken
+ * with the DWT cycle counter on the board.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PID_BENCH_HAS_TSC 1
+#endif
+
+extern "C" {
+#include "APP/PID/pid.h"
+}
+
+namespace {
+
+const PID_ConfigType kGains = {
+    PID_GAIN(0.2), PID_GAIN(0.004), PID_GAIN(0.05), PID_GAIN(0.25), 0, PID_DUTY_MAX / 2,
+};
+
+/* Setpoint sequence cycled through during the run, Q8 °C */
+const int16_t kSetpointsQ8[] = { 25 * 256, 35 * 256, 30 * 256, 20 * 256 };
+
+struct Plant {
+    int32_t i32TempQ16 = 20 << 16;
+
+    /* Heating proportional to duty, loss proportional to the gap to a 20°C cabin */
+    int16_t step(uint16_t ui16Duty)
+    {
+        i32TempQ16 += (int32_t)ui16Duty * 2 - ((i32TempQ16 - (20 << 16)) >> 7);
+        return (int16_t)(i32TempQ16 >> 8);
+    }
+};
+
+struct Result {
+    double dNanoseconds;
+    uint64_t ui64Ticks;
+    uint32_t ui32Checksum;
+};
+
+template <bool kRunPid>
+Result run(uint32_t ui32Iterations)
+{
+    PID_StateType sState;
+    Plant sPlant;
+    int16_t i16TempQ8 = sPlant.step(0);
+    uint32_t ui32Checksum = 0;
+    uint16_t ui16Duty = 0;
+
+    PID_reset(&sState, i16TempQ8);
+
+    auto xStart = std::chrono::steady_clock::now();
+#ifdef PID_BENCH_HAS_TSC
+    uint64_t ui64Start = __rdtsc();
+#endif
+    for (uint32_t i = 0; i < ui32Iterations; i++) {
+        int16_t i16SetpointQ8 = kSetpointsQ8[(i >> 12) & 3];
+        if (kRunPid) {
+            ui16Duty = PID_update(&kGains, &sState, i16SetpointQ8, i16TempQ8);
+        } else {
+            /* Same data flow without the controller, used as the baseline */
+            ui16Duty = (uint16_t)((i16SetpointQ8 - i16TempQ8) & 0x7FFF);
+        }
+        i16TempQ8 = sPlant.step(ui16Duty);
+        ui32Checksum += ui16Duty;
+    }
+#ifdef PID_BENCH_HAS_TSC
+    uint64_t ui64Ticks = __rdtsc() - ui64Start;
+#else
+    uint64_t ui64Ticks = 0;
+#endif
+    auto xElapsed = std::chrono::steady_clock::now() - xStart;
+
+    return { std::chrono::duration<double, std::nano>(xElapsed).count(), ui64Ticks, ui32Checksum };
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    uint32_t ui32Iterations = (argc > 1) ? (uint32_t)std::strtoul(argv[1], nullptr, 0) : 50000000u;
+
+    /* Warm up caches and frequency scaling */
+    run<true>(ui32Iterations / 10);
+
+    Result sBaseline = run<false>(ui32Iterations);
+    Result sPid = run<true>(ui32Iterations);
+
+    double dNs = (sPid.dNanoseconds - sBaseline.dNanoseconds) / ui32Iterations;
+    std::printf("iterations          : %u\n", ui32Iterations);
+    std::printf("PID_update          : %.2f ns/iteration\n", dNs);
+#ifdef PID_BENCH_HAS_TSC
+    double dTicks = (double)(int64_t)(sPid.ui64Ticks - sBaseline.ui64Ticks) / ui32Iterations;
+    std::printf("PID_update          : %.1f TSC ticks/iteration\n", dTicks);
+#endif
+    std::printf("loop with model     : %.2f ns/iteration\n", sPid.dNanoseconds / ui32Iterations);
+    std::printf("checksum            : %u / %u\n", sPid.ui32Checksum, sBaseline.ui32Checksum);
+    return 0;
+}
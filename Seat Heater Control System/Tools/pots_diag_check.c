@@ -0,0 +1,124 @@
+/*
+ * pots_diag_check.c
+ *
+ * Host check of the seat sensor plausibility diagnosis (Project/HAL/POTS/pots_diag.c). Raw
+ * samples are driven through POTS_diagUpdate() at POTS_DIAG_SAMPLE_RATE_HZ, the heater flag
+ * follows what APP/SEAT/seat.c does with a faulty channel, and every fault must be set and
+ * cleared within its debounce and heal time:
+ *
+ *     gcc -O2 -I../Project pots_diag_check.c ../Project/HAL/POTS/pots_diag.c -o pots_diag_check
+ *     ./pots_diag_check
+ */
+
+#include <stdio.h>
+#include "HAL/POTS/pots_diag.h"
+
+#define LIVE_RAW        2000U       /* mid scale code of a healthy sensor */
+
+static uint32_t ui32Seed = 12345;
+static unsigned long ulChecks = 0;
+static unsigned long ulFailures = 0;
+
+/* A live input: a few LSBs of noise around ui16Value */
+static uint16_t live(uint16_t ui16Value)
+{
+    ui32Seed = ui32Seed * 1664525u + 1013904223u;
+    return (uint16_t)(ui16Value + (ui32Seed >> 29) - 3);
+}
+
+/* ui32Ms of samples, live noise around ui16Value or a constant code. Returns the time in
+ * ms at which the ui8Bit fault first reads bSet, -1 when it never did */
+static long drive(POTS_DiagStateType *psDiag, uint32_t ui32Ms, uint16_t ui16Value, bool bLive,
+                  uint8_t ui8Bit, bool bSet)
+{
+    uint32_t ui32Sample;
+    uint32_t ui32Samples = POTS_DIAG_MS_TO_SAMPLES(ui32Ms);
+    long lAt = -1;
+
+    for(ui32Sample = 0; ui32Sample < ui32Samples; ui32Sample++){
+        uint16_t ui16Raw = bLive ? live(ui16Value) : ui16Value;
+        bool bFault = (POTS_diagUpdate(psDiag, ui16Raw, ui16Raw) & ui8Bit) != 0;
+
+        if((lAt < 0) && (bFault == bSet)){
+            lAt = (long)(ui32Sample * 1000U / POTS_DIAG_SAMPLE_RATE_HZ);
+        }
+    }
+    return lAt;
+}
+
+/* lAt must lie within [lMin, lMax] ms, -1 for "never" */
+static void expect(const char *pcWhat, long lAt, long lMin, long lMax)
+{
+    bool bPass = (lMin < 0) ? (lAt < 0) : ((lAt >= lMin) && (lAt <= lMax));
+
+    ulChecks++;
+    if(!bPass){
+        ulFailures++;
+    }
+    printf("%-48s %8ld ms  %s\n", pcWhat, lAt, bPass ? "ok" : "FAILED");
+}
+
+int main(void)
+{
+    const long lStuckMs = POTS_DIAG_STUCK_TIME_MS;
+    const long lSampleMs = 1000L / POTS_DIAG_SAMPLE_RATE_HZ;
+    POTS_DiagStateType sDiag;
+
+    /* A live sensor is never flagged, heater on or off */
+    POTS_diagInit(&sDiag, LIVE_RAW);
+    sDiag.bHeating = true;
+    expect("live, heater on: any fault (never)", drive(&sDiag, 3 * lStuckMs, LIVE_RAW, true, 0xFU, true), -1, -1);
+    sDiag.bHeating = false;
+    expect("live, heater off: any fault (never)", drive(&sDiag, 3 * lStuckMs, LIVE_RAW, true, 0xFU, true), -1, -1);
+
+    /* A frozen input is only stuck while the heater should move it */
+    POTS_diagInit(&sDiag, LIVE_RAW);
+    expect("frozen, heater off: stuck (never)", drive(&sDiag, 3 * lStuckMs, LIVE_RAW, false, POTS_DIAG_STUCK, true), -1, -1);
+
+    /* Set with the heater on, then the seat turns the heater off on the fault */
+    sDiag.bHeating = true;
+    expect("frozen, heater on: stuck set",
+           drive(&sDiag, 2 * lStuckMs, LIVE_RAW, false, POTS_DIAG_STUCK, true), lStuckMs - lSampleMs, lStuckMs);
+    sDiag.bHeating = false;
+    expect("still frozen, heater off: stuck cleared (never)",
+           drive(&sDiag, 3 * lStuckMs, LIVE_RAW, false, POTS_DIAG_STUCK, false), -1, -1);
+    expect("live again, heater off: stuck cleared",
+           drive(&sDiag, 3 * lStuckMs, LIVE_RAW, true, POTS_DIAG_STUCK, false), 0,
+           POTS_DIAG_STUCK_HEAL * lStuckMs);
+    expect("frozen, heater off after heal: stuck (never)",
+           drive(&sDiag, 3 * lStuckMs, LIVE_RAW, false, POTS_DIAG_STUCK, true), -1, -1);
+
+    /* Open and short circuits set on every sample and heal with the heater off */
+    POTS_diagInit(&sDiag, LIVE_RAW);
+    expect("open circuit: open set", drive(&sDiag, 1000, 4095, false, POTS_DIAG_OPEN, true),
+           (POTS_DIAG_OPEN_SHORT_DEBOUNCE - 1) * lSampleMs, (POTS_DIAG_OPEN_SHORT_DEBOUNCE - 1) * lSampleMs);
+    expect("reconnected: open cleared", drive(&sDiag, 1000, LIVE_RAW, true, POTS_DIAG_OPEN, false),
+           (POTS_DIAG_OPEN_SHORT_HEAL - 1) * lSampleMs, (POTS_DIAG_OPEN_SHORT_HEAL - 1) * lSampleMs);
+    expect("short to ground: short set", drive(&sDiag, 1000, 0, false, POTS_DIAG_SHORT, true),
+           (POTS_DIAG_OPEN_SHORT_DEBOUNCE - 1) * lSampleMs, (POTS_DIAG_OPEN_SHORT_DEBOUNCE - 1) * lSampleMs);
+    expect("reconnected: short cleared", drive(&sDiag, 1000, LIVE_RAW, true, POTS_DIAG_SHORT, false),
+           (POTS_DIAG_OPEN_SHORT_HEAL - 1) * lSampleMs, (POTS_DIAG_OPEN_SHORT_HEAL - 1) * lSampleMs);
+
+    /* A level jumping between two codes on every rate interval */
+    POTS_diagInit(&sDiag, LIVE_RAW);
+    {
+        long lAt = -1;
+        uint8_t ui8Step;
+
+        for(ui8Step = 0; (ui8Step < 2 * POTS_DIAG_RATE_DEBOUNCE) && (lAt < 0); ui8Step++){
+            lAt = drive(&sDiag, POTS_DIAG_RATE_INTERVAL_MS,
+                        (ui8Step & 1U) ? LIVE_RAW : (LIVE_RAW + 4U * POTS_DIAG_RATE_MAX_RAW), true,
+                        POTS_DIAG_RATE, true);
+            if(lAt >= 0){
+                lAt += (long)ui8Step * POTS_DIAG_RATE_INTERVAL_MS;
+            }
+        }
+        expect("jumping level: rate set", lAt, 0, POTS_DIAG_RATE_DEBOUNCE * POTS_DIAG_RATE_INTERVAL_MS);
+    }
+    expect("steady: rate cleared",
+           drive(&sDiag, 2 * POTS_DIAG_RATE_HEAL * POTS_DIAG_RATE_INTERVAL_MS, LIVE_RAW, true, POTS_DIAG_RATE, false),
+           0, (POTS_DIAG_RATE_HEAL + 1) * POTS_DIAG_RATE_INTERVAL_MS);
+
+    printf("%lu checks, %lu failures\n", ulChecks, ulFailures);
+    return (ulFailures == 0) ? 0 : 1;
+}
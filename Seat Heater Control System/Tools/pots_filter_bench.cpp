@@ -0,0 +1,250 @@
+/*
+ * pots_filter_bench.cpp
+ *
+ * Host check and benchmark of the seat sensor filtering pipeline (Project/HAL/POTS/pots_filter.h)
+ * with the configuration of the target. The median and IIR stages are compiled from the
+ * unchanged target sources, the kernel headers pulled in by pots.h are replaced by the type
+ * stand-ins of sim/:
+ *
+ *     P=../Project
+ *     gcc -O2 -I$P -c $P/HAL/POTS/pots_filter.c -o pots_filter.o
+ *     g++ -O2 -std=c++17 -Isim -I$P -I$P/Common pots_filter_bench.cpp pots_filter.o -o pots_filter_bench
+ *     ./pots_filter_bench [samples]
+ *
+ * The input is a slowly moving sensor code with gaussian noise on every conversion and
+ * spikes on whole samples. Every stage is compared with a reference, a mismatch fails the
+ * run:
+ *  - oversampling: done by the ADC on the target, modeled here as the truncated average of
+ *    POTS_FILTER_HW_OVERSAMPLE conversions, checked against the mean in double. It costs no
+ *    CPU on the target, the time only covers the model
+ *  - median: POTS_filterMedian() against std::nth_element over the same window, bit exact
+ *  - IIR: POTS_filterIir() at the block rate, after the block average of pots.c, against the
+ *    same low pass in double, within 1 LSB
+ * The RMS error against the noiseless code is printed after every stage. The timings are
+ * the cost of one call with the cost of the same loop without the stage subtracted, they
+ * only give the relative cost: the Cortex-M4 figure has to be taken with the DWT cycle
+ * counter on the board.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "HAL/POTS/pots.h"
+#include "HAL/POTS/pots_filter.h"
+}
+
+namespace {
+
+constexpr unsigned kOversample = (POTS_FILTER_HW_OVERSAMPLE > 1) ? POTS_FILTER_HW_OVERSAMPLE : 1;
+constexpr double kNoiseLsb = 12.0;
+constexpr unsigned kSpikeEvery = 97;        /* samples, spikes are not periodic on the target */
+constexpr int kSpikeLsb = 600;
+
+struct Input {
+    std::vector<uint16_t> xConversions;     /* kOversample per sample */
+    std::vector<double> xTrue;              /* noiseless code of every sample */
+};
+
+Input makeInput(uint32_t ui32Samples)
+{
+    std::mt19937 xRandom(12345);
+    std::normal_distribution<double> xNoise(0.0, kNoiseLsb);
+    Input sInput;
+
+    sInput.xConversions.reserve((size_t)ui32Samples * kOversample);
+    sInput.xTrue.reserve(ui32Samples);
+    for (uint32_t i = 0; i < ui32Samples; i++) {
+        /* Seat warming and cooling over minutes at the 1 kHz sample rate */
+        double dTrue = 2048.0 + 1200.0 * std::sin(i * 2.0e-6);
+        int iSpike = ((i % kSpikeEvery) == 0) ? (((i / kSpikeEvery) & 1) ? kSpikeLsb : -kSpikeLsb) : 0;
+
+        sInput.xTrue.push_back(dTrue);
+        for (unsigned uConversion = 0; uConversion < kOversample; uConversion++) {
+            long lCode = std::lround(dTrue + xNoise(xRandom)) + iSpike;
+            sInput.xConversions.push_back((uint16_t)std::clamp(lCode, 0L, (long)(POTS_MAX_VALUE - 1)));
+        }
+    }
+    return sInput;
+}
+
+/* What the ADC averager hands over for one sample */
+uint16_t modelOversample(const uint16_t *pui16Conversions)
+{
+    uint32_t ui32Sum = 0;
+
+    for (unsigned uConversion = 0; uConversion < kOversample; uConversion++) {
+        ui32Sum += pui16Conversions[uConversion];
+    }
+    return (uint16_t)(ui32Sum / kOversample);
+}
+
+/* Against the noiseless code in the middle of the samples each value stands for */
+double rmsError(const std::vector<uint16_t> &xValues, const std::vector<double> &xTrue, double dSamplesPerValue)
+{
+    double dSum = 0.0;
+
+    for (size_t i = 0; i < xValues.size(); i++) {
+        double dError = xValues[i] - xTrue[(size_t)((i + 0.5) * dSamplesPerValue)];
+        dSum += dError * dError;
+    }
+    return std::sqrt(dSum / (double)xValues.size());
+}
+
+unsigned long g_ulChecks = 0;
+unsigned long g_ulMismatches = 0;
+
+void check(bool bMatch, const char *pcStage, size_t uIndex, double dExpected, unsigned uGot)
+{
+    g_ulChecks++;
+    if (!bMatch && (g_ulMismatches++ < 10)) {
+        std::fprintf(stderr, "%s, sample %zu: %u instead of %.3f\n", pcStage, uIndex, uGot, dExpected);
+    }
+}
+
+std::vector<uint16_t> checkOversample(const Input &sInput)
+{
+    std::vector<uint16_t> xOut(sInput.xTrue.size());
+
+    for (size_t i = 0; i < xOut.size(); i++) {
+        const uint16_t *pui16Conversions = &sInput.xConversions[i * kOversample];
+        double dMean = 0.0;
+
+        for (unsigned uConversion = 0; uConversion < kOversample; uConversion++) {
+            dMean += pui16Conversions[uConversion];
+        }
+        dMean /= kOversample;
+        xOut[i] = modelOversample(pui16Conversions);
+        check(xOut[i] == (uint16_t)std::floor(dMean), "oversampling", i, dMean, xOut[i]);
+    }
+    return xOut;
+}
+
+std::vector<uint16_t> checkMedian(const std::vector<uint16_t> &xIn)
+{
+    std::vector<uint16_t> xOut(xIn.size());
+    std::vector<uint16_t> xWindow(POTS_FILTER_MEDIAN_SIZE, xIn[0]);
+    POTS_FilterStateType sFilter;
+
+    POTS_filterInit(&sFilter, xIn[0]);
+    for (size_t i = 0; i < xIn.size(); i++) {
+        std::vector<uint16_t> xSorted;
+
+        xWindow[i % POTS_FILTER_MEDIAN_SIZE] = xIn[i];
+        xSorted = xWindow;
+        std::nth_element(xSorted.begin(), xSorted.begin() + POTS_FILTER_MEDIAN_SIZE / 2, xSorted.end());
+        xOut[i] = POTS_filterMedian(&sFilter, xIn[i]);
+        check(xOut[i] == xSorted[POTS_FILTER_MEDIAN_SIZE / 2], "median", i, xSorted[POTS_FILTER_MEDIAN_SIZE / 2],
+              xOut[i]);
+    }
+    return xOut;
+}
+
+/* Block average of pots.c, one value per POTS_STREAM_BLOCK_SIZE samples */
+std::vector<uint16_t> decimate(const std::vector<uint16_t> &xIn)
+{
+    std::vector<uint16_t> xOut;
+
+    for (size_t i = 0; i + POTS_STREAM_BLOCK_SIZE <= xIn.size(); i += POTS_STREAM_BLOCK_SIZE) {
+        uint32_t ui32Sum = 0;
+
+        for (size_t uSample = 0; uSample < POTS_STREAM_BLOCK_SIZE; uSample++) {
+            ui32Sum += xIn[i + uSample];
+        }
+        xOut.push_back((uint16_t)(ui32Sum >> POTS_STREAM_BLOCK_SHIFT));
+    }
+    return xOut;
+}
+
+std::vector<uint16_t> checkIir(const std::vector<uint16_t> &xIn)
+{
+    std::vector<uint16_t> xOut(xIn.size());
+    POTS_FilterStateType sFilter;
+    double dState = xIn[0];
+
+    POTS_filterInit(&sFilter, xIn[0]);
+    for (size_t i = 0; i < xIn.size(); i++) {
+        dState += (xIn[i] - dState) / (double)(1u << POTS_FILTER_IIR_SHIFT);
+        xOut[i] = POTS_filterIir(&sFilter, xIn[i]);
+        check(std::fabs(xOut[i] - dState) <= 1.0, "IIR", i, dState, xOut[i]);
+    }
+    return xOut;
+}
+
+/* ns per call of the stage, the same loop without the stage is subtracted */
+template <typename Stage>
+double timeStage(const std::vector<uint16_t> &xIn, uint32_t ui32Stride, Stage xStage)
+{
+    double pdNs[2];
+    volatile uint32_t ui32Sink = 0;
+
+    for (int iRun = 0; iRun < 2; iRun++) {
+        POTS_FilterStateType sFilter;
+        uint32_t ui32Checksum = 0;
+
+        POTS_filterInit(&sFilter, xIn[0]);
+        auto xStart = std::chrono::steady_clock::now();
+        for (size_t i = 0; i + ui32Stride <= xIn.size(); i += ui32Stride) {
+            ui32Checksum += (iRun == 1) ? xStage(&sFilter, &xIn[i]) : xIn[i];
+        }
+        pdNs[iRun] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - xStart).count();
+        ui32Sink = ui32Sink + ui32Checksum;
+    }
+    return (pdNs[1] - pdNs[0]) / (double)(xIn.size() / ui32Stride);
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    uint32_t ui32Samples = (argc > 1) ? (uint32_t)std::strtoul(argv[1], nullptr, 0) : 4000000u;
+
+    ui32Samples -= ui32Samples % POTS_STREAM_BLOCK_SIZE;
+    if (ui32Samples == 0) {
+        std::fprintf(stderr, "at least %u samples\n", (unsigned)POTS_STREAM_BLOCK_SIZE);
+        return 1;
+    }
+
+    Input sInput = makeInput(ui32Samples);
+    std::vector<uint16_t> xOversampled = checkOversample(sInput);
+    std::vector<uint16_t> xMedian = checkMedian(xOversampled);
+    std::vector<uint16_t> xBlocks = decimate(xMedian);
+    std::vector<uint16_t> xFiltered = checkIir(xBlocks);
+    if (g_ulMismatches != 0) {
+        std::printf("%lu of %lu outputs differ from the references\n", g_ulMismatches, g_ulChecks);
+        return 1;
+    }
+    std::printf("%lu outputs match the references\n", g_ulChecks);
+    std::printf("oversample %u, median %u, block %u, IIR shift %u, %u samples\n\n", kOversample,
+                (unsigned)POTS_FILTER_MEDIAN_SIZE, (unsigned)POTS_STREAM_BLOCK_SIZE, (unsigned)POTS_FILTER_IIR_SHIFT,
+                ui32Samples);
+
+    /* Warm up caches and frequency scaling */
+    timeStage(sInput.xConversions, kOversample,
+              [](POTS_FilterStateType *, const uint16_t *pui16In) { return modelOversample(pui16In); });
+
+    double dOversampleNs = timeStage(sInput.xConversions, kOversample,
+                                     [](POTS_FilterStateType *, const uint16_t *pui16In) {
+                                         return modelOversample(pui16In);
+                                     });
+    double dMedianNs = timeStage(xOversampled, 1, [](POTS_FilterStateType *psFilter, const uint16_t *pui16In) {
+        return POTS_filterMedian(psFilter, *pui16In);
+    });
+    double dIirNs = timeStage(xBlocks, 1, [](POTS_FilterStateType *psFilter, const uint16_t *pui16In) {
+        return POTS_filterIir(psFilter, *pui16In);
+    });
+
+    std::printf("%-22s %10s %12s\n", "stage", "ns/call", "RMS err LSB");
+    std::printf("%-22s %10s %12.2f\n", "conversion", "-", rmsError(sInput.xConversions, sInput.xTrue, 1.0 / kOversample));
+    std::printf("%-22s %10.2f %12.2f\n", "oversampling (model)", dOversampleNs, rmsError(xOversampled, sInput.xTrue, 1.0));
+    std::printf("%-22s %10.2f %12.2f\n", "median", dMedianNs, rmsError(xMedian, sInput.xTrue, 1.0));
+    std::printf("%-22s %10s %12.2f\n", "block average", "-", rmsError(xBlocks, sInput.xTrue, POTS_STREAM_BLOCK_SIZE));
+    std::printf("%-22s %10.2f %12.2f\n", "IIR", dIirNs, rmsError(xFiltered, sInput.xTrue, POTS_STREAM_BLOCK_SIZE));
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * seat_fsm_check.c
+ *
+ * Host check of the generated heater state machine (APP/SEAT/seat_fsm_table.h) against the
+ * nested if/else chain it replaces. Every heater state, heating level, setpoint, temperature
+ * and initial LED state is tried, the next state and the resulting LEDs must be identical:
+ *
+ *     gcc -O2 -I../Project -I../Project/Common seat_fsm_check.c ../Project/APP/SEAT/seat_fsm.c -o seat_fsm_check
+ *     ./seat_fsm_check
+ */
+
+#include <stdio.h>
+#include "APP/SEAT/seat.h"
+#include "APP/SEAT/seat_fsm.h"
+
+static uint8 ui8Leds;
+
+static void ledOn(uint8 ui8Led)  { ui8Leds |= ui8Led; }
+static void ledOff(uint8 ui8Led) { ui8Leds &= (uint8)~ui8Led; }
+
+/* The decision of the original vSeat1AdjustHeaterTask for a healthy sensor */
+static HeaterStateType reference(HeaterStateType heaterState, HeatingLevelType heatingLevel,
+                                 uint8 ui8seat1DesiredTempValueC, uint8 ui8seat1CurrentTempValueC)
+{
+    if((ui8seat1DesiredTempValueC > ui8seat1CurrentTempValueC) && (heatingLevel != HEATING_OFF)){
+
+        if((ui8seat1DesiredTempValueC - ui8seat1CurrentTempValueC) >= 10){
+            heaterState = HEATER_HIGH;
+            ledOff(SEAT_LED_RED);
+            ledOn(SEAT_LED_GREEN);
+            ledOff(SEAT_LED_BLUE);
+        }
+        else if((ui8seat1DesiredTempValueC - ui8seat1CurrentTempValueC) >= 5){
+            heaterState = HEATER_MEDIUM;
+            ledOff(SEAT_LED_RED);
+            ledOff(SEAT_LED_GREEN);
+            ledOn(SEAT_LED_BLUE);
+        }
+        else if(
+                (((ui8seat1DesiredTempValueC - ui8seat1CurrentTempValueC) >= 2) && (heaterState != HEATER_OFF)) ||
+                (((ui8seat1DesiredTempValueC - ui8seat1CurrentTempValueC) > 3) && (heaterState == HEATER_OFF))
+        )
+        {
+            heaterState = HEATER_LOW;
+            ledOff(SEAT_LED_RED);
+            ledOn(SEAT_LED_GREEN);
+            ledOn(SEAT_LED_BLUE);
+        }
+        else{
+            heaterState = HEATER_OFF;
+            ledOff(SEAT_LED_GREEN);
+            ledOff(SEAT_LED_BLUE);
+        }
+    }
+    else{
+        heaterState = HEATER_OFF;
+        ledOff(SEAT_LED_RED);
+        ledOff(SEAT_LED_GREEN);
+        ledOff(SEAT_LED_BLUE);
+    }
+    return heaterState;
+}
+
+int main(void)
+{
+    unsigned long ulCases = 0;
+    unsigned long ulMismatches = 0;
+    int iState, iLevel, iDesired, iCurrent, iLeds;
+
+    for(iState = HEATER_OFF; iState <= HEATER_HIGH; iState++){
+        for(iLevel = HEATING_OFF; iLevel <= HEATING_HIGH; iLevel++){
+            for(iDesired = 0; iDesired < 256; iDesired++){
+                for(iCurrent = 0; iCurrent < 256; iCurrent++){
+                    uint8 ui8Entry = SEAT_fsmStep((HeaterStateType)iState, (HeatingLevelType)iLevel,
+                                                  (uint8)iDesired, (uint8)iCurrent);
+
+                    for(iLeds = 0; iLeds < 8; iLeds++){
+                        HeaterStateType eExpected;
+                        uint8 ui8ExpectedLeds;
+                        uint8 ui8TableLeds;
+
+                        ui8Leds = (uint8)iLeds;
+                        eExpected = reference((HeaterStateType)iState, (HeatingLevelType)iLevel,
+                                              (uint8)iDesired, (uint8)iCurrent);
+                        ui8ExpectedLeds = ui8Leds;
+
+                        ui8TableLeds = (uint8)((iLeds & ~SEAT_FSM_LEDS_OFF(ui8Entry)) | SEAT_FSM_LEDS_ON(ui8Entry));
+
+                        ulCases++;
+                        if((eExpected != SEAT_FSM_NEXT_STATE(ui8Entry)) || (ui8ExpectedLeds != ui8TableLeds)){
+                            if(ulMismatches++ < 10){
+                                printf("mismatch: state %d level %d desired %d current %d leds %d -> "
+                                       "expected %d/%d, table %d/%d\n", iState, iLevel, iDesired, iCurrent, iLeds,
+                                       eExpected, ui8ExpectedLeds, SEAT_FSM_NEXT_STATE(ui8Entry), ui8TableLeds);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%lu cases, %lu mismatches\n", ulCases, ulMismatches);
+    return (ulMismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,409 @@
+/*
+ * seat_sim.cpp
+ *
+ * Simulated HAL and scheduler of the seat heater closed-loop simulation (seat_sim.h).
+ * The control code is compiled from the unchanged target sources, the kernel headers are
+ * replaced by the type stand-ins of sim/:
+ *
+ *     P=../Project
+ *     gcc -O2 -c -Isim -I$P -I$P/Common -I$P/MCAL/GPIO -I$P/MCAL/GPTM \
+ *         $P/APP/SEAT/seat.c $P/APP/SEAT/seat_fsm.c $P/APP/SEAT/seat_cfg.c \
+ *         $P/APP/PID/pid.c $P/APP/POWER/power.c $P/APP/GESTURE/gesture.c \
+ *         $P/HAL/POTS/pots_lut.c $P/Common/sample_ring.c
+ *     g++ -O2 -std=c++17 -Isim -I$P -I$P/Common -I$P/MCAL/GPIO -I$P/MCAL/GPTM \
+ *         seat_sim.cpp seat_sim_main.cpp *.o -o seat_sim
+ *     ./seat_sim [repeat]
+ *
+ * What is simulated, in the order of the target:
+ *  - POTS: once per 32 ms block the surface temperature of each seat (plus noise) is turned
+ *    into an ADC code through the inverse of the sensor table and back with POTS_lutToTempQ8(),
+ *    so the control sees the real quantization. Samples and POTS_TEMP_EVENT() follow the
+ *    deadband / keepalive rule of pots.c, the validity window is the one the ADC comparators
+ *    get from POTS_lutFindWindow(). The median / IIR filters and the plausibility checks are
+ *    not modeled.
+ *  - Input task: the level is selected with one click per step of the first button of each
+ *    seat in seat_cfg.c, handed to SEAT_buttonEvent() as already debounced events. The clicks
+ *    are spaced beyond the double press gap of sSeatGestureConfig.
+ *    SEAT_buttonTimeout() runs on the deadline given by SEAT_getButtonTimeoutMs().
+ *  - Control engine: runs on the events of SEAT_getEventMask() or after SEAT_getTimeoutMs(),
+ *    exactly like vSeatsControlTask().
+ *  - HEATER: the granted duty is averaged over the 200 Hz PWM period, which is three orders
+ *    of magnitude shorter than the thermal time constants.
+ *
+ * Time is kept in microseconds, the unit of GPTM_WTimer1Read(). On LP64 hosts uint32 is
+ * 64 bits wide, the simulated timer is never wrapped.
+ */
+
+#include "seat_sim.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "APP/SEAT/seat.h"
+#include <HAL/POTS/pots.h>
+#include <HAL/POTS/pots_lut.h>
+#include <HAL/HEATER/heater.h>
+#include "HAL/RGB_LED/rgb.h"
+#include "GPTM.h"
+#include "gpio.h"
+#include "sample_ring.h"
+}
+
+
+namespace {
+
+constexpr uint64_t kUsPerMs = 1000;
+constexpr uint64_t kBlockUs = (uint64_t)POTS_STREAM_BLOCK_SIZE * 1000000u / POTS_STREAM_SAMPLE_RATE_HZ;
+constexpr uint64_t kPressUs = 100 * kUsPerMs;
+constexpr uint64_t kPressPauseUs = 100 * kUsPerMs;   /* release beyond the double press gap */
+/* The simulated clock starts late enough for the backdated keepalive of POTS_init() */
+constexpr uint64_t kBootUs = (uint64_t)POTS_SAMPLE_KEEPALIVE_MS * kUsPerMs;
+
+struct SeatModel {
+    double dHeaterC;
+    double dSurfaceC;
+    double dEnergyJ;
+    bool bOccupied;
+};
+
+struct SensorChannel {
+    SAMPLE_RingType sRing;
+    int16_t i16LatestTempQ8;
+    int16_t i16AnnouncedTempQ8;
+    uint64_t ui64LastPushUs;
+    bool bInWindow;
+};
+
+/* State of the simulated board, one simulation per process */
+struct Board {
+    uint64_t ui64NowUs;
+    uint32_t ui32Events;
+    SensorChannel psChannels[POTS_NUM_CHANNELS];
+    uint16_t pui16HeaterDuty[HEATER_NUM_OUTPUTS];
+    uint8_t ui8RgbLeds;
+    uint8_t ui8BuiltinLeds;
+};
+
+Board sBoard;
+
+/* ADC code giving a temperature, inverse of POTS_lutToTempQ8() by binary search */
+struct SensorInverse {
+    bool bRising;
+    uint16_t ui16WindowLow;
+    uint16_t ui16WindowHigh;
+
+    SensorInverse()
+    {
+        bRising = POTS_lutToTempQ8(0x0FFF) > POTS_lutToTempQ8(0);
+        POTS_lutFindWindow((int16_t)(POTS_VALID_TEMP_MIN_C << POTS_TEMP_Q8_SHIFT),
+                           (int16_t)(POTS_VALID_TEMP_MAX_C << POTS_TEMP_Q8_SHIFT),
+                           &ui16WindowLow, &ui16WindowHigh);
+    }
+
+    uint16_t rawFor(double dTempC) const
+    {
+        int32_t i32TempQ8 = (int32_t)std::lround(dTempC * (1 << POTS_TEMP_Q8_SHIFT));
+        uint16_t ui16Low = 0;
+        uint16_t ui16High = 0x0FFF;
+
+        /* First code whose temperature reaches the target in the direction of the sensor */
+        while (ui16Low < ui16High) {
+            uint16_t ui16Mid = (uint16_t)((ui16Low + ui16High) / 2);
+            bool bBelow = POTS_lutToTempQ8(bRising ? ui16Mid : (uint16_t)(0x0FFF - ui16Mid)) < i32TempQ8;
+            if (bBelow) {
+                ui16Low = (uint16_t)(ui16Mid + 1);
+            } else {
+                ui16High = ui16Mid;
+            }
+        }
+        return bRising ? ui16Low : (uint16_t)(0x0FFF - ui16Low);
+    }
+};
+
+const SensorInverse &sensorInverse()
+{
+    static const SensorInverse sInverse;
+    return sInverse;
+}
+
+/* One ADC block: new sample of every channel, same push and event policy as pots.c */
+void potsBlock(const SeatModel *psSeats, std::mt19937 &xRandom, double dNoiseC)
+{
+    const SensorInverse &sInverse = sensorInverse();
+    std::normal_distribution<double> xNoise(0.0, dNoiseC);
+
+    for (uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        uint8_t ui8Channel = psSeatConfig[ui8Seat].ui8SensorChannel;
+        SensorChannel &sChannel = sBoard.psChannels[ui8Channel];
+        double dReadingC = psSeats[ui8Seat].dSurfaceC + ((dNoiseC > 0.0) ? xNoise(xRandom) : 0.0);
+        uint16_t ui16Raw = sInverse.rawFor(dReadingC);
+        bool bInWindow = (ui16Raw >= sInverse.ui16WindowLow) && (ui16Raw <= sInverse.ui16WindowHigh);
+        SAMPLE_Type sSample;
+        int32_t i32Delta;
+        bool bPush;
+
+        sSample.ui32Timestamp = (uint32)sBoard.ui64NowUs;
+        sSample.i16TempQ8 = POTS_lutToTempQ8(ui16Raw);
+        sSample.ui8Channel = ui8Channel;
+        sSample.ui8Faults = 0;
+        sChannel.i16LatestTempQ8 = sSample.i16TempQ8;
+
+        if (bInWindow != sChannel.bInWindow) {
+            sChannel.bInWindow = bInWindow;
+            sBoard.ui32Events |= POTS_RANGE_EVENT(ui8Channel);
+        }
+
+        i32Delta = sSample.i16TempQ8 - sChannel.i16AnnouncedTempQ8;
+        bPush = (sBoard.ui64NowUs - sChannel.ui64LastPushUs) >= (uint64_t)POTS_SAMPLE_KEEPALIVE_MS * kUsPerMs;
+        if ((i32Delta >= POTS_TEMP_EVENT_DEADBAND_Q8) || (i32Delta <= -POTS_TEMP_EVENT_DEADBAND_Q8)) {
+            sChannel.i16AnnouncedTempQ8 = sSample.i16TempQ8;
+            sBoard.ui32Events |= POTS_TEMP_EVENT(ui8Channel);
+            bPush = true;
+        }
+        if (bPush) {
+            SAMPLE_ringPush(&sChannel.sRing, &sSample);
+            sChannel.ui64LastPushUs = sBoard.ui64NowUs;
+        }
+    }
+}
+
+/* Explicit Euler step, stable as long as dt is far below the heater node time constant */
+void plantStep(SeatModel &sSeat, const seat_sim::PlantParams &sPlant, double dAmbientC, double dDutyFraction,
+               double dDtS)
+{
+    double dPowerW = sPlant.dHeaterPowerW * dDutyFraction;
+    double dToSurfaceW = sPlant.dHeaterToSurfaceWK * (sSeat.dHeaterC - sSeat.dSurfaceC);
+    double dLossW = sPlant.dSurfaceToAmbientWK * (sSeat.dSurfaceC - dAmbientC);
+
+    if (sSeat.bOccupied) {
+        dLossW += sPlant.dOccupantWK * (sSeat.dSurfaceC - sPlant.dOccupantC);
+    }
+    sSeat.dHeaterC += (dPowerW - dToSurfaceW) * dDtS / sPlant.dHeaterCapJK;
+    sSeat.dSurfaceC += (dToSurfaceW - dLossW) * dDtS / sPlant.dSurfaceCapJK;
+    sSeat.dEnergyJ += dPowerW * dDtS;
+}
+
+struct ButtonEdge {
+    uint64_t ui64TimeUs;
+    uint8_t ui8Button;
+    bool bPressed;
+};
+
+/* Press and release edges selecting the level of every seat, kPressUs long clicks from
+ * dSelectS, sorted by time */
+std::vector<ButtonEdge> buttonEdges(const seat_sim::Scenario &sScenario)
+{
+    std::vector<ButtonEdge> xEdges;
+    uint64_t ui64SelectUs = kBootUs + (uint64_t)(sScenario.dSelectS * 1e6);
+    uint64_t ui64PressPeriodUs = kPressUs + (uint64_t)sSeatGestureConfig.ui16DoubleGapMs * kUsPerMs + kPressPauseUs;
+
+    for (uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        uint8_t ui8Button = (uint8_t)__builtin_ctz(psSeatConfig[ui8Seat].ui8Buttons);
+
+        for (uint64_t ui64Press = 0; ui64Press < (uint64_t)sScenario.psSeats[ui8Seat].eLevel; ui64Press++) {
+            uint64_t ui64PressUs = ui64SelectUs + ui64Press * ui64PressPeriodUs;
+            xEdges.push_back({ ui64PressUs, ui8Button, true });
+            xEdges.push_back({ ui64PressUs + kPressUs, ui8Button, false });
+        }
+    }
+    std::stable_sort(xEdges.begin(), xEdges.end(),
+                     [](const ButtonEdge &sA, const ButtonEdge &sB) { return sA.ui64TimeUs < sB.ui64TimeUs; });
+    return xEdges;
+}
+
+/* xTrace[u] is the surface temperature (u + 1) blocks after boot */
+seat_sim::SeatMetrics seatMetrics(const std::vector<float> &xTrace, double dSelectS, double dSetpointC,
+                                  double dEnergyJ)
+{
+    const double dBlockS = (double)kBlockUs / 1e6;
+    seat_sim::SeatMetrics sMetrics = {};
+    size_t uFirst = std::min(xTrace.size(), (size_t)std::max(0.0, std::ceil(dSelectS / dBlockS) - 1.0));
+    size_t uTail = xTrace.size() - xTrace.size() / 5;
+    double dSum = 0.0;
+    double dMax = -1e9;
+
+    for (size_t u = uTail; u < xTrace.size(); u++) {
+        dSum += xTrace[u];
+    }
+    sMetrics.dFinalC = (xTrace.size() > uTail) ? dSum / (double)(xTrace.size() - uTail) : 0.0;
+    for (size_t u = uFirst; u < xTrace.size(); u++) {
+        dMax = std::max(dMax, (double)xTrace[u]);
+    }
+
+    /* First sample of the final stretch spent inside the band */
+    size_t uSettled = xTrace.size();
+    while ((uSettled > uFirst) && (std::fabs(xTrace[uSettled - 1] - sMetrics.dFinalC) <= seat_sim::kSettleBandC)) {
+        uSettled--;
+    }
+
+    sMetrics.dSetpointC = dSetpointC;
+    sMetrics.dSettleS = (uSettled < uTail) ? std::max(0.0, (double)(uSettled + 1) * dBlockS - dSelectS) : -1.0;
+    sMetrics.dOvershootC = std::max(0.0, dMax - dSetpointC);
+    sMetrics.dSteadyErrorC = sMetrics.dFinalC - dSetpointC;
+    sMetrics.dEnergyWh = dEnergyJ / 3600.0;
+    return sMetrics;
+}
+
+}  // namespace
+
+/* ---------------------------------------------------------------- simulated HAL */
+
+extern "C" {
+
+uint32 GPTM_WTimer1Read(void)
+{
+    return (uint32)sBoard.ui64NowUs;
+}
+
+int16_t POTS_getLatestTempQ8(uint8_t ui8Channel)
+{
+    return sBoard.psChannels[ui8Channel].i16LatestTempQ8;
+}
+
+uint32_t POTS_readSamples(uint8_t ui8Channel, SAMPLE_Type *psSamples, uint32_t ui32MaxSamples)
+{
+    return SAMPLE_ringPopBatch(&sBoard.psChannels[ui8Channel].sRing, psSamples, ui32MaxSamples);
+}
+
+bool POTS_isChannelHealthy(uint8_t ui8Channel)
+{
+    return sBoard.psChannels[ui8Channel].bInWindow;
+}
+
+void POTS_diagSetHeating(uint8_t ui8Channel, bool bHeating)
+{
+    (void)ui8Channel;
+    (void)bHeating;
+}
+
+void HEATER_setPulse(uint8_t ui8Output, uint16_t ui16DutyQ15, uint16_t ui16PhaseQ15)
+{
+    (void)ui16PhaseQ15;
+    sBoard.pui16HeaterDuty[ui8Output] = ui16DutyQ15;
+}
+
+void RGB_RedLedOn(void)      { sBoard.ui8RgbLeds |= SEAT_LED_RED; }
+void RGB_RedLedOff(void)     { sBoard.ui8RgbLeds &= (uint8_t)~SEAT_LED_RED; }
+void RGB_GreenLedOn(void)    { sBoard.ui8RgbLeds |= SEAT_LED_GREEN; }
+void RGB_GreenLedOff(void)   { sBoard.ui8RgbLeds &= (uint8_t)~SEAT_LED_GREEN; }
+void RGB_BlueLedOn(void)     { sBoard.ui8RgbLeds |= SEAT_LED_BLUE; }
+void RGB_BlueLedOff(void)    { sBoard.ui8RgbLeds &= (uint8_t)~SEAT_LED_BLUE; }
+
+void GPIO_RedLedOn(void)     { sBoard.ui8BuiltinLeds |= SEAT_LED_RED; }
+void GPIO_RedLedOff(void)    { sBoard.ui8BuiltinLeds &= (uint8_t)~SEAT_LED_RED; }
+void GPIO_GreenLedOn(void)   { sBoard.ui8BuiltinLeds |= SEAT_LED_GREEN; }
+void GPIO_GreenLedOff(void)  { sBoard.ui8BuiltinLeds &= (uint8_t)~SEAT_LED_GREEN; }
+void GPIO_BlueLedOn(void)    { sBoard.ui8BuiltinLeds |= SEAT_LED_BLUE; }
+void GPIO_BlueLedOff(void)   { sBoard.ui8BuiltinLeds &= (uint8_t)~SEAT_LED_BLUE; }
+
+}  // extern "C"
+
+/* ---------------------------------------------------------------- scheduler */
+
+namespace seat_sim {
+
+RunMetrics run(const Scenario &sScenario, const PlantParams &sPlant, uint32_t ui32Seed)
+{
+    static SystemStateStructureType sSystemState;
+    static std::vector<float> pxTrace[SEAT_COUNT];
+    std::mt19937 xRandom(ui32Seed);
+    SeatModel psSeats[SEAT_COUNT];
+    RunMetrics sResult = {};
+    uint64_t ui64EndUs = kBootUs + (uint64_t)(sScenario.dDurationS * 1e6);
+    uint64_t ui64PlantUs = kBootUs;
+    uint64_t ui64NextBlockUs = kBootUs + kBlockUs;
+    uint64_t ui64NextRepeatUs = UINT64_MAX;
+    std::vector<ButtonEdge> xEdges = buttonEdges(sScenario);
+    size_t uNextEdge = 0;
+    uint64_t ui64EngineDeadlineUs = kBootUs;
+
+    sBoard = Board();
+    sBoard.ui64NowUs = kBootUs;
+    sSystemState = SystemStateStructureType();
+    for (uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        psSeats[ui8Seat] = { sScenario.dInitialC, sScenario.dInitialC, 0.0, false };
+        pxTrace[ui8Seat].clear();
+        pxTrace[ui8Seat].reserve((size_t)((ui64EndUs - kBootUs) / kBlockUs) + 1);
+    }
+
+    /* POTS_init(): seeded from a first conversion, the backdated keepalive makes the first
+     * block push a sample */
+    potsBlock(psSeats, xRandom, 0.0);
+    for (uint8_t ui8Channel = 0; ui8Channel < POTS_NUM_CHANNELS; ui8Channel++) {
+        SensorChannel &sChannel = sBoard.psChannels[ui8Channel];
+        SAMPLE_ringInit(&sChannel.sRing);
+        sChannel.i16AnnouncedTempQ8 = sChannel.i16LatestTempQ8;
+        sChannel.ui64LastPushUs = kBootUs - (uint64_t)POTS_SAMPLE_KEEPALIVE_MS * kUsPerMs;
+    }
+    sBoard.ui32Events = 0;
+
+    SEAT_init(&sSystemState);
+
+    for (;;) {
+        uint64_t ui64NextEdgeUs = (uNextEdge < xEdges.size()) ? xEdges[uNextEdge].ui64TimeUs : UINT64_MAX;
+        uint64_t ui64NextInputUs = std::min(ui64NextEdgeUs, ui64NextRepeatUs);
+        uint64_t ui64NextUs = std::min(std::min(ui64NextBlockUs, ui64NextInputUs), ui64EngineDeadlineUs);
+        if (ui64NextUs >= ui64EndUs) {
+            break;
+        }
+
+        /* The heaters keep their duty between two events */
+        if (ui64NextUs > ui64PlantUs) {
+            double dDtS = (double)(ui64NextUs - ui64PlantUs) / 1e6;
+            double dNowS = (double)(ui64PlantUs - kBootUs) / 1e6;
+            for (uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+                double dDuty = (double)sBoard.pui16HeaterDuty[psSeatConfig[ui8Seat].ui8HeaterOutput] / HEATER_DUTY_MAX;
+                double dOccupiedFromS = sScenario.psSeats[ui8Seat].dOccupiedFromS;
+                psSeats[ui8Seat].bOccupied = (dOccupiedFromS >= 0.0) && (dNowS >= dOccupiedFromS);
+                plantStep(psSeats[ui8Seat], sPlant, sScenario.dAmbientC, dDuty, dDtS);
+            }
+            ui64PlantUs = ui64NextUs;
+        }
+        sBoard.ui64NowUs = ui64NextUs;
+
+        if (ui64NextBlockUs == ui64NextUs) {
+            potsBlock(psSeats, xRandom, sPlant.dSensorNoiseC);
+            for (uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+                pxTrace[ui8Seat].push_back((float)psSeats[ui8Seat].dSurfaceC);
+            }
+            ui64NextBlockUs += kBlockUs;
+        }
+
+        /* vSeatsInputTask(): woken by a button event or by its repeat deadline */
+        if (ui64NextInputUs == ui64NextUs) {
+            uint32_t ui32TimeoutMs;
+
+            while ((uNextEdge < xEdges.size()) && (xEdges[uNextEdge].ui64TimeUs == ui64NextUs)) {
+                const ButtonEdge &sEdge = xEdges[uNextEdge++];
+                sBoard.ui32Events |= SEAT_buttonEvent(sEdge.ui8Button, sEdge.bPressed, (uint32)sEdge.ui64TimeUs);
+            }
+            sBoard.ui32Events |= SEAT_buttonTimeout((uint32)ui64NextUs);
+            ui32TimeoutMs = SEAT_getButtonTimeoutMs((uint32)ui64NextUs);
+            ui64NextRepeatUs = (ui32TimeoutMs == SEAT_NO_TIMEOUT) ? UINT64_MAX : ui64NextUs + (uint64_t)ui32TimeoutMs * kUsPerMs;
+        }
+
+        /* vSeatsControlTask(): woken by its events or by the timeout of the wait */
+        if (((sBoard.ui32Events & SEAT_getEventMask()) != 0) || (ui64EngineDeadlineUs == ui64NextUs)) {
+            sBoard.ui32Events &= ~SEAT_getEventMask();
+            for (uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+                SEAT_adjustHeater(ui8Seat, (uint32)ui64NextUs);
+            }
+            SEAT_applyPower();
+            sResult.ui32EngineRuns++;
+            ui64EngineDeadlineUs = ui64NextUs + (uint64_t)SEAT_getTimeoutMs() * kUsPerMs;
+        }
+    }
+
+    for (uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        double dSetpointC = psSeatConfig[ui8Seat].pui8SetpointsC[sScenario.psSeats[ui8Seat].eLevel];
+        sResult.psSeats[ui8Seat] = seatMetrics(pxTrace[ui8Seat], sScenario.dSelectS, dSetpointC,
+                                               psSeats[ui8Seat].dEnergyJ);
+    }
+    sResult.dSimulatedS = sScenario.dDurationS;
+    return sResult;
+}
+
+}  // namespace seat_sim
@@ -0,0 +1,76 @@
+/*
+ * seat_sim.h
+ *
+ * Closed-loop host simulation of the seat heaters: a thermal model of every seat behind a
+ * simulated POTS / GPIO / RGB / HEATER / GPTM HAL, driving the unchanged control code
+ * (APP/SEAT, APP/PID, APP/POWER). See seat_sim.cpp for the build.
+ *
+ * The control code keeps its state in file scope variables, so one process runs one
+ * simulation at a time.
+ */
+
+#ifndef SEAT_SIM_H_
+#define SEAT_SIM_H_
+
+#include <cstdint>
+
+extern "C" {
+#include <heatingsystem.h>
+}
+
+namespace seat_sim {
+
+/* Two-node model of a seat: the heater mat (heater node) warms the cover (surface node)
+ * where the sensor sits, the cover loses heat to the cabin and exchanges heat with the
+ * occupant once seated. A first-order seat is obtained with a small dHeaterCapJK */
+struct PlantParams {
+    double dHeaterPowerW = 60.0;            /* at full duty, 12 V x 5 A */
+    double dHeaterCapJK = 40.0;             /* heat capacity of the heater mat */
+    double dSurfaceCapJK = 600.0;           /* heat capacity of the cover and foam */
+    double dHeaterToSurfaceWK = 4.0;
+    double dSurfaceToAmbientWK = 1.5;
+    double dOccupantWK = 3.0;               /* contact conductance with the occupant */
+    double dOccupantC = 34.0;               /* skin temperature */
+    double dSensorNoiseC = 0.05;            /* RMS noise added to the sensor reading */
+};
+
+struct SeatScenario {
+    HeatingLevelType eLevel;                /* selected with button presses at dSelectS */
+    double dOccupiedFromS;                  /* occupant sits down at this time, < 0 never */
+};
+
+struct Scenario {
+    const char *pcName;
+    double dAmbientC;
+    double dInitialC;                       /* seat temperature at power up */
+    double dDurationS;
+    double dSelectS;
+    SeatScenario psSeats[SEAT_COUNT];
+};
+
+/* Metrics are taken on the surface temperature of the model, not on the sensor reading.
+ * Settling is measured against the final temperature (average of the last 20 % of the run):
+ * the threshold controller holds the seat below its setpoint by design */
+struct SeatMetrics {
+    double dSetpointC;
+    double dSettleS;                        /* from the level selection, < 0 never settled */
+    double dOvershootC;                     /* above the setpoint, 0 when never exceeded */
+    double dFinalC;
+    double dSteadyErrorC;                   /* final temperature - setpoint */
+    double dEnergyWh;                       /* electrical energy of the heater */
+};
+
+struct RunMetrics {
+    SeatMetrics psSeats[SEAT_COUNT];
+    uint32_t ui32EngineRuns;                /* activations of the control engine */
+    double dSimulatedS;
+};
+
+/* Settling band around the final temperature */
+constexpr double kSettleBandC = 0.5;
+
+RunMetrics run(const Scenario &sScenario, const PlantParams &sPlant, uint32_t ui32Seed = 1);
+
+}  // namespace seat_sim
+
+#endif /* SEAT_SIM_H_ */
@@ -0,0 +1,80 @@
+/*
+ * seat_sim_main.cpp
+ *
+ * Runs the built-in heat-up scenarios through the closed-loop simulation (seat_sim.h) with
+ * the seat configuration of APP/SEAT/seat_cfg.c, prints the metrics of every seat and the
+ * simulation speed. The whole batch is run [repeat] times for the speed figure, build
+ * instructions in seat_sim.cpp.
+ */
+
+#include "seat_sim.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using seat_sim::Scenario;
+
+const Scenario kScenarios[] = {
+    /* name                 ambient initial duration select   seat 1                    seat 2 */
+    { "low_10C",             10.0,   10.0,   1200.0,  1.0,  { { HEATING_LOW,    -1.0 }, { HEATING_OFF,    -1.0 } } },
+    { "medium_10C",          10.0,   10.0,   1200.0,  1.0,  { { HEATING_MEDIUM, -1.0 }, { HEATING_OFF,    -1.0 } } },
+    { "high_10C",            10.0,   10.0,   1200.0,  1.0,  { { HEATING_HIGH,   -1.0 }, { HEATING_OFF,    -1.0 } } },
+    { "high_both_10C",       10.0,   10.0,   1200.0,  1.0,  { { HEATING_HIGH,   -1.0 }, { HEATING_HIGH,   -1.0 } } },
+    { "high_occupied_15C",   15.0,   15.0,   1200.0,  1.0,  { { HEATING_HIGH,  120.0 }, { HEATING_MEDIUM, 120.0 } } },
+    { "medium_warm_cabin",   28.0,   28.0,    600.0,  1.0,  { { HEATING_MEDIUM, -1.0 }, { HEATING_LOW,    -1.0 } } },
+    { "cold_out_of_window",   2.0,    2.0,    600.0,  1.0,  { { HEATING_HIGH,   -1.0 }, { HEATING_OFF,    -1.0 } } },
+};
+
+const char *const kLevelNames[] = { "OFF", "LOW", "MEDIUM", "HIGH" };
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned uRepeat = (argc > 1) ? (unsigned)std::strtoul(argv[1], nullptr, 0) : 20u;
+    seat_sim::PlantParams sPlant;
+    double dSimulatedS = 0.0;
+
+    std::printf("%-20s %4s %-6s %5s %9s %9s %8s %8s %8s %7s\n", "scenario", "seat", "level", "set C",
+                "settle s", "overshoot", "final C", "error C", "energy", "wakeups");
+    for (const Scenario &sScenario : kScenarios) {
+        seat_sim::RunMetrics sRun = seat_sim::run(sScenario, sPlant);
+
+        for (unsigned uSeat = 0; uSeat < SEAT_COUNT; uSeat++) {
+            const seat_sim::SeatMetrics &sSeat = sRun.psSeats[uSeat];
+            char pcSettle[16];
+
+            if (sScenario.psSeats[uSeat].eLevel == HEATING_OFF) {
+                std::printf("%-20s %4u %-6s %5s %9s %9s %8.2f %8s %6.2fWh %7s\n",
+                            (uSeat == 0) ? sScenario.pcName : "", uSeat + 1, "OFF", "-", "-", "-",
+                            sSeat.dFinalC, "-", sSeat.dEnergyWh, "");
+                continue;
+            }
+            if (sSeat.dSettleS < 0.0) {
+                std::snprintf(pcSettle, sizeof(pcSettle), "never");
+            } else {
+                std::snprintf(pcSettle, sizeof(pcSettle), "%.1f", sSeat.dSettleS);
+            }
+            std::printf("%-20s %4u %-6s %5.0f %9s %9.2f %8.2f %8.2f %6.2fWh %7u\n",
+                        (uSeat == 0) ? sScenario.pcName : "", uSeat + 1, kLevelNames[sScenario.psSeats[uSeat].eLevel],
+                        sSeat.dSetpointC, pcSettle, sSeat.dOvershootC, sSeat.dFinalC, sSeat.dSteadyErrorC,
+                        sSeat.dEnergyWh, sRun.ui32EngineRuns);
+        }
+    }
+
+    auto xStart = std::chrono::steady_clock::now();
+    for (unsigned uPass = 0; uPass < uRepeat; uPass++) {
+        for (const Scenario &sScenario : kScenarios) {
+            dSimulatedS += seat_sim::run(sScenario, sPlant, uPass + 1).dSimulatedS;
+        }
+    }
+    double dWallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - xStart).count();
+
+    std::printf("\n%u x %zu scenarios: %.0f simulated minutes in %.3f s, %.0f simulated minutes per second\n",
+                uRepeat, sizeof(kScenarios) / sizeof(kScenarios[0]), dSimulatedS / 60.0, dWallS,
+                dSimulatedS / 60.0 / dWallS);
+    return 0;
+}
@@ -0,0 +1,370 @@
+/*
+ * seat_sweep.cpp
+ *
+ * Controller tuning sweep on top of the closed-loop simulation (seat_sim.h). Every
+ * combination of setpoint, hysteresis of the threshold controller, PID gains and cabin
+ * temperature is simulated, seat 1 runs the threshold state machine and seat 2 the PID so
+ * one run scores both controllers under the same conditions.
+ *
+ *     P=../Project
+ *     gcc -O2 -c -Isim -I$P -I$P/Common -I$P/MCAL/GPIO -I$P/MCAL/GPTM \
+ *         $P/APP/SEAT/seat.c $P/APP/PID/pid.c $P/APP/POWER/power.c $P/APP/GESTURE/gesture.c \
+ *         $P/HAL/POTS/pots_lut.c $P/Common/sample_ring.c
+ *     g++ -O2 -std=c++17 -Isim -I$P -I$P/Common -I$P/MCAL/GPIO -I$P/MCAL/GPTM \
+ *         seat_sim.cpp seat_sweep.cpp *.o -o seat_sweep
+ *     ./seat_sweep [output.csv] [workers]
+ *
+ * seat_cfg.c is replaced by the sweep configuration below and seat_fsm.c by a state machine
+ * built at run time with the rules of gen_seat_fsm.py, checked at start up against the
+ * generated APP/SEAT/seat_fsm_table.h for the shipped thresholds.
+ *
+ * The control code keeps its state in file scope variables, so the runs are spread over
+ * worker processes rather than threads: each worker is forked with its own copy of the
+ * firmware and pulls run indices from an atomic counter in shared memory until the sweep is
+ * exhausted. The metrics are stored column by column in shared memory and written out as CSV
+ * once every worker is done.
+ */
+
+#include "seat_sim.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern "C" {
+#include "APP/SEAT/seat.h"
+#include "APP/SEAT/seat_fsm.h"
+#include <HAL/POTS/pots.h>
+#include <HAL/HEATER/heater.h>
+#include "HAL/RGB_LED/rgb.h"
+#include "HAL/INPUT/input.h"
+#include "gpio.h"
+}
+
+namespace {
+
+/* ---------------------------------------------------------------- sweep axes */
+
+const uint8_t kSetpointsC[] = { 25, 28, 30, 32, 35 };
+
+/* Threshold controller, LOW rule: error needed to switch on from OFF and to stay on */
+struct LowBand {
+    uint8_t ui8EnterC;
+    uint8_t ui8HoldC;
+};
+const LowBand kLowBands[] = {
+    { 3, 1 }, { 3, 2 }, { 3, 3 },
+    { 4, 1 }, { 4, 2 }, { 4, 3 },
+    { 5, 1 }, { 5, 2 }, { 5, 3 },
+};
+
+const double kKp[] = { 0.1, 0.2, 0.4, 0.8 };
+const double kKi[] = { 0.002, 0.004, 0.008, 0.016 };
+const double kAmbientC[] = { 8.0, 15.0, 22.0 };
+
+constexpr double kDurationS = 900.0;
+
+template <typename T, size_t N>
+constexpr size_t count(const T (&)[N])
+{
+    return N;
+}
+
+constexpr size_t kRuns = count(kSetpointsC) * count(kLowBands) * count(kKp) * count(kKi) * count(kAmbientC);
+
+struct RunParams {
+    uint8_t ui8SetpointC;
+    LowBand sLowBand;
+    double dKp;
+    double dKi;
+    double dAmbientC;
+};
+
+/* Mixed radix decoding of a run index, the ambient temperature varies fastest */
+RunParams decode(size_t uRun)
+{
+    RunParams sParams;
+
+    sParams.dAmbientC = kAmbientC[uRun % count(kAmbientC)];
+    uRun /= count(kAmbientC);
+    sParams.dKi = kKi[uRun % count(kKi)];
+    uRun /= count(kKi);
+    sParams.dKp = kKp[uRun % count(kKp)];
+    uRun /= count(kKp);
+    sParams.sLowBand = kLowBands[uRun % count(kLowBands)];
+    uRun /= count(kLowBands);
+    sParams.ui8SetpointC = kSetpointsC[uRun];
+    return sParams;
+}
+
+/* ---------------------------------------------------------------- result columns */
+
+enum Column {
+    COL_SETPOINT_C,
+    COL_AMBIENT_C,
+    COL_LOW_ENTER_C,
+    COL_LOW_HOLD_C,
+    COL_KP,
+    COL_KI,
+    COL_THR_SETTLE_S,
+    COL_THR_OVERSHOOT_C,
+    COL_THR_ERROR_C,
+    COL_THR_ENERGY_WH,
+    COL_PID_SETTLE_S,
+    COL_PID_OVERSHOOT_C,
+    COL_PID_ERROR_C,
+    COL_PID_ENERGY_WH,
+    COL_WAKEUPS,
+    COL_COUNT
+};
+
+const char *const kColumnNames[COL_COUNT] = {
+    "setpoint_c", "ambient_c", "low_enter_c", "low_hold_c", "kp", "ki",
+    "thr_settle_s", "thr_overshoot_c", "thr_error_c", "thr_energy_wh",
+    "pid_settle_s", "pid_overshoot_c", "pid_error_c", "pid_energy_wh",
+    "wakeups",
+};
+
+/* Shared between the workers: next run to take, then one array of kRuns values per column */
+struct SharedSweep {
+    std::atomic<uint32_t> xNextRun;
+    double pdColumns[COL_COUNT][kRuns];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "the run counter is shared between processes");
+
+/* ---------------------------------------------------------------- seat configuration */
+
+uint8 pui8SweepSetpointsC[] = { 0, 25, 30, 35 };
+PID_ConfigType sSweepPidGains = {
+    PID_GAIN(0.2), PID_GAIN(0.004), PID_GAIN(0.0), PID_GAIN(0.25), 0, PID_DUTY_MAX / 2,
+};
+
+const SEAT_LedDriverType sSweepRgbLeds = {
+    RGB_RedLedOn,   RGB_RedLedOff,
+    RGB_GreenLedOn, RGB_GreenLedOff,
+    RGB_BlueLedOn,  RGB_BlueLedOff,
+};
+
+const SEAT_LedDriverType sSweepBuiltinLeds = {
+    GPIO_RedLedOn,   GPIO_RedLedOff,
+    GPIO_GreenLedOn, GPIO_GreenLedOff,
+    GPIO_BlueLedOn,  GPIO_BlueLedOff,
+};
+
+/* Enough budget for both heaters, the controllers must not interfere */
+const uint16 pui16SweepHeaterCurrentMa[SEAT_COUNT] = { 5000, 5000 };
+const uint8 pui8SweepPowerOrder[SEAT_COUNT] = { 0, 1 };
+
+/* Threshold state machine in use, rebuilt for every run */
+uint8 pui8SweepFsmTable[4][SEAT_FSM_ERROR_BANDS];
+
+/* Port of decide() / pack() of gen_seat_fsm.py */
+void buildFsmTable(uint8_t ui8LowEnterC, uint8_t ui8LowHoldC)
+{
+    struct Rule {
+        HeaterStateType eState;
+        uint8_t ui8EnterC;
+        uint8_t ui8HoldC;
+        uint8_t ui8LedsOn;
+        uint8_t ui8LedsOff;
+    };
+    const Rule psRules[] = {
+        { HEATER_HIGH,   10,          10,          SEAT_LED_GREEN,                  SEAT_LED_RED | SEAT_LED_BLUE },
+        { HEATER_MEDIUM,  5,           5,          SEAT_LED_BLUE,                   SEAT_LED_RED | SEAT_LED_GREEN },
+        { HEATER_LOW,    ui8LowEnterC, ui8LowHoldC, SEAT_LED_GREEN | SEAT_LED_BLUE, SEAT_LED_RED },
+    };
+    const uint8_t ui8AllLeds = SEAT_LED_RED | SEAT_LED_GREEN | SEAT_LED_BLUE;
+
+    for (int iState = HEATER_OFF; iState <= HEATER_HIGH; iState++) {
+        for (int iError = 0; iError < SEAT_FSM_ERROR_BANDS; iError++) {
+            uint8_t ui8Next = HEATER_OFF;
+            uint8_t ui8On = 0;
+            uint8_t ui8Off = ui8AllLeds;
+
+            if (iError > 0) {
+                ui8Off = SEAT_LED_GREEN | SEAT_LED_BLUE;
+                for (const Rule &sRule : psRules) {
+                    if (iError >= ((iState != HEATER_OFF) ? sRule.ui8HoldC : sRule.ui8EnterC)) {
+                        ui8Next = sRule.eState;
+                        ui8On = sRule.ui8LedsOn;
+                        ui8Off = sRule.ui8LedsOff;
+                        break;
+                    }
+                }
+            }
+            pui8SweepFsmTable[iState][iError] = (uint8_t)(ui8Next | (ui8On << SEAT_FSM_LEDS_ON_SHIFT) |
+                                                          (ui8Off << SEAT_FSM_LEDS_OFF_SHIFT));
+        }
+    }
+}
+
+}  // namespace
+
+extern "C" {
+
+const POWER_ConfigType sSeatPowerConfig = {
+    10000, POWER_POLICY_PRIORITY, SEAT_COUNT, pui16SweepHeaterCurrentMa, pui8SweepPowerOrder,
+};
+
+const GESTURE_ConfigType sSeatGestureConfig = {
+    1000, 300, 400, 500,
+};
+
+const SEAT_ConfigType psSeatConfig[SEAT_COUNT] = {
+    { POTS_SEAT1_CHANNEL, HEATER_SEAT1_OUTPUT, INPUT_MASK(INPUT_SW1), &sSweepRgbLeds,     pui8SweepSetpointsC, SEAT_CONTROL_THRESHOLD, &sSweepPidGains },
+    { POTS_SEAT2_CHANNEL, HEATER_SEAT2_OUTPUT, INPUT_MASK(INPUT_SW2), &sSweepBuiltinLeds, pui8SweepSetpointsC, SEAT_CONTROL_PID,       &sSweepPidGains },
+};
+
+/* Same saturation as seat_fsm.c, on the table of the current run */
+uint8 SEAT_fsmStep(HeaterStateType eState, HeatingLevelType eLevel, uint8 ui8DesiredTempC, uint8 ui8CurrentTempC)
+{
+    sint16 i16ErrorC = (sint16)ui8DesiredTempC - ui8CurrentTempC;
+
+    if ((eLevel == HEATING_OFF) || (i16ErrorC < 0)) {
+        i16ErrorC = 0;
+    }
+    if (i16ErrorC >= SEAT_FSM_ERROR_BANDS) {
+        i16ErrorC = SEAT_FSM_ERROR_BANDS - 1;
+    }
+    return pui8SweepFsmTable[eState][i16ErrorC];
+}
+
+}  // extern "C"
+
+namespace {
+
+void runOne(SharedSweep &sShared, size_t uRun)
+{
+    RunParams sParams = decode(uRun);
+    seat_sim::Scenario sScenario = {
+        "sweep", sParams.dAmbientC, sParams.dAmbientC, kDurationS, 1.0,
+        { { HEATING_HIGH, -1.0 }, { HEATING_HIGH, -1.0 } },
+    };
+    seat_sim::PlantParams sPlant;
+
+    pui8SweepSetpointsC[HEATING_HIGH] = sParams.ui8SetpointC;
+    sSweepPidGains.i32Kp = PID_GAIN(sParams.dKp);
+    sSweepPidGains.i32Ki = PID_GAIN(sParams.dKi);
+    buildFsmTable(sParams.sLowBand.ui8EnterC, sParams.sLowBand.ui8HoldC);
+
+    seat_sim::RunMetrics sRun = seat_sim::run(sScenario, sPlant, (uint32_t)uRun + 1);
+    const seat_sim::SeatMetrics &sThr = sRun.psSeats[0];
+    const seat_sim::SeatMetrics &sPid = sRun.psSeats[1];
+    double pdRow[COL_COUNT] = {
+        (double)sParams.ui8SetpointC, sParams.dAmbientC,
+        (double)sParams.sLowBand.ui8EnterC, (double)sParams.sLowBand.ui8HoldC, sParams.dKp, sParams.dKi,
+        sThr.dSettleS, sThr.dOvershootC, sThr.dSteadyErrorC, sThr.dEnergyWh,
+        sPid.dSettleS, sPid.dOvershootC, sPid.dSteadyErrorC, sPid.dEnergyWh,
+        (double)sRun.ui32EngineRuns,
+    };
+
+    for (int iColumn = 0; iColumn < COL_COUNT; iColumn++) {
+        sShared.pdColumns[iColumn][uRun] = pdRow[iColumn];
+    }
+}
+
+void worker(SharedSweep &sShared)
+{
+    const uint32_t ui32Chunk = 4;
+
+    for (;;) {
+        uint32_t ui32First = sShared.xNextRun.fetch_add(ui32Chunk, std::memory_order_relaxed);
+        if (ui32First >= kRuns) {
+            return;
+        }
+        for (uint32_t ui32Run = ui32First; (ui32Run < ui32First + ui32Chunk) && (ui32Run < kRuns); ui32Run++) {
+            runOne(sShared, ui32Run);
+        }
+    }
+}
+
+bool writeCsv(const SharedSweep &sShared, const char *pcPath)
+{
+    FILE *pxFile = std::fopen(pcPath, "w");
+    if (pxFile == nullptr) {
+        return false;
+    }
+    for (int iColumn = 0; iColumn < COL_COUNT; iColumn++) {
+        std::fprintf(pxFile, "%s%c", kColumnNames[iColumn], (iColumn == COL_COUNT - 1) ? '\n' : ',');
+    }
+    for (size_t uRun = 0; uRun < kRuns; uRun++) {
+        for (int iColumn = 0; iColumn < COL_COUNT; iColumn++) {
+            std::fprintf(pxFile, "%.6g%c", sShared.pdColumns[iColumn][uRun], (iColumn == COL_COUNT - 1) ? '\n' : ',');
+        }
+    }
+    return std::fclose(pxFile) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    const char *pcOutput = (argc > 1) ? argv[1] : "seat_sweep.csv";
+    unsigned uWorkers = (argc > 2) ? (unsigned)std::strtoul(argv[2], nullptr, 0) : std::thread::hardware_concurrency();
+    std::vector<pid_t> xWorkers;
+
+    if (uWorkers == 0) {
+        uWorkers = 1;
+    }
+
+    /* The state machine built for the shipped thresholds must be the generated one */
+    buildFsmTable(4, 2);
+    if (std::memcmp(pui8SweepFsmTable, pui8SeatFsmTable, sizeof(pui8SweepFsmTable)) != 0) {
+        std::fprintf(stderr, "error: state machine builder out of sync with seat_fsm_table.h\n");
+        return 1;
+    }
+
+    void *pvShared = mmap(nullptr, sizeof(SharedSweep), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (pvShared == MAP_FAILED) {
+        std::perror("mmap");
+        return 1;
+    }
+    SharedSweep &sShared = *new (pvShared) SharedSweep();
+    sShared.xNextRun.store(0);
+
+    auto xStart = std::chrono::steady_clock::now();
+    std::fflush(stdout);
+    for (unsigned uWorker = 0; uWorker < uWorkers; uWorker++) {
+        pid_t xPid = fork();
+        if (xPid == 0) {
+            worker(sShared);
+            _exit(0);
+        }
+        if (xPid < 0) {
+            std::perror("fork");
+            break;
+        }
+        xWorkers.push_back(xPid);
+    }
+
+    bool bFailed = xWorkers.empty();
+    for (pid_t xPid : xWorkers) {
+        int iStatus = 0;
+        if ((waitpid(xPid, &iStatus, 0) < 0) || !WIFEXITED(iStatus) || (WEXITSTATUS(iStatus) != 0)) {
+            bFailed = true;
+        }
+    }
+    double dWallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - xStart).count();
+    if (bFailed) {
+        std::fprintf(stderr, "error: a worker failed\n");
+        return 1;
+    }
+
+    if (!writeCsv(sShared, pcOutput)) {
+        std::perror(pcOutput);
+        return 1;
+    }
+    std::printf("%zu runs of %.0f s on %zu workers in %.2f s: %.0f runs/s, %.0f simulated minutes per second\n",
+                kRuns, kDurationS, xWorkers.size(), dWallS, kRuns / dWallS, kRuns * kDurationS / 60.0 / dWallS);
+    std::printf("metrics written to %s\n", pcOutput);
+    return 0;
+}
@@ -0,0 +1,18 @@
+/*
+ * FreeRTOS.h
+ *
+ * Host stand-in for the kernel header, only the types used in the declarations of the
+ * HAL headers are provided so the control code can be compiled by Tools/seat_sim.
+ */
+
+#ifndef SIM_FREERTOS_H_
+#define SIM_FREERTOS_H_
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef unsigned long TickType_t;
+
+#define pdFALSE     ((BaseType_t)0)
+#define pdTRUE      ((BaseType_t)1)
+
+#endif /* SIM_FREERTOS_H_ */
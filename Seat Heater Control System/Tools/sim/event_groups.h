@@ -0,0 +1,16 @@
+/*
+ * event_groups.h
+ *
+ * Host stand-in for the kernel header, see sim/FreeRTOS.h. The simulator keeps the
+ * event bits itself.
+ */
+
+#ifndef SIM_EVENT_GROUPS_H_
+#define SIM_EVENT_GROUPS_H_
+
+#include "FreeRTOS.h"
+
+typedef void *EventGroupHandle_t;
+typedef TickType_t EventBits_t;
+
+#endif /* SIM_EVENT_GROUPS_H_ */
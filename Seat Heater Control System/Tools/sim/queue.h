@@ -0,0 +1,15 @@
+/*
+ * queue.h
+ *
+ * Host stand-in for the kernel header, see sim/FreeRTOS.h. The simulator hands the
+ * debounced button events to the control code directly.
+ */
+
+#ifndef SIM_QUEUE_H_
+#define SIM_QUEUE_H_
+
+#include "FreeRTOS.h"
+
+typedef void *QueueHandle_t;
+
+#endif /* SIM_QUEUE_H_ */
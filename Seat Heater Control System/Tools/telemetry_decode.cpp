@@ -0,0 +1,356 @@
+/*
+ * telemetry_decode.cpp
+ *
+ * Host decoder of the binary status records of vDisplaySystemStateTask (DISPLAY_MODE_BINARY,
+ * layout in Project/APP/TELEMETRY/telemetry.h). Reads a raw capture of the UART, for
+ * example `cat /dev/ttyACM0 > capture.bin`, applies every delta on top of the last
+ * keyframe and prints the full state after each valid record as CSV or JSON. The COBS and
+ * CRC code is compiled from the unchanged target sources:
+ *
+ *     P=../Project
+ *     gcc -O2 -c -I$P/Common $P/Common/cobs.c $P/Common/crc16.c
+ *     g++ -O2 -std=c++17 -I$P -I$P/Common telemetry_decode.cpp cobs.o crc16.o -o telemetry_decode
+ *     ./telemetry_decode [--json] [capture.bin]      (stdin without a file)
+ *
+ * Anything between two delimiters that is not a valid record (text printed by the other
+ * tasks, a frame cut by a reconnection) is skipped and counted, the counts are printed on
+ * stderr at the end. Deltas received before the first keyframe or after a sequence gap
+ * have no base: they are dropped until the next keyframe. The deferred log frames of the
+ * same stream are only counted, Tools/log_decode prints them.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "APP/TELEMETRY/telemetry.h"
+#include "crc16.h"
+}
+
+namespace {
+
+const char *const kLevelNames[] = { "OFF", "LOW", "MEDIUM", "HIGH" };
+
+struct SeatRecord {
+    unsigned uTempC;
+    unsigned uLevel;
+    unsigned uHeater;
+    unsigned uRequestedQ15;
+    unsigned uDutyQ15;
+};
+
+struct StateRecord {
+    bool bKeyframe;
+    unsigned uSequence;
+    uint32_t ui32TimestampMs;
+    unsigned uCpuLoad;
+    unsigned uGrantedMa;
+    unsigned uRequestedMa;
+    std::vector<SeatRecord> xSeats;
+};
+
+struct Counters {
+    unsigned long ulRecords = 0;
+    unsigned long ulNotCobs = 0;        /* text or cut frames */
+    unsigned long ulBadCrc = 0;
+    unsigned long ulBadLayout = 0;      /* unknown version / type or wrong length */
+    unsigned long ulSequenceGaps = 0;
+    unsigned long ulKeyframes = 0;
+    unsigned long ulUnsynced = 0;       /* deltas without a base */
+    unsigned long ulLogFrames = 0;
+};
+
+unsigned get16(const uint8_t *pui8In)
+{
+    return (unsigned)pui8In[0] | ((unsigned)pui8In[1] << 8);
+}
+
+uint32_t get32(const uint8_t *pui8In)
+{
+    return (uint32_t)get16(pui8In) | ((uint32_t)get16(pui8In + 2) << 16);
+}
+
+const char *levelName(unsigned uLevel)
+{
+    return (uLevel < sizeof(kLevelNames) / sizeof(kLevelNames[0])) ? kLevelNames[uLevel] : "?";
+}
+
+double dutyPercent(unsigned uQ15)
+{
+    return 100.0 * uQ15 / 32767.0;
+}
+
+/* Keyframe without its CRC, false if the layout does not match */
+bool parseState(const uint8_t *pui8Record, size_t uLength, StateRecord &sRecord)
+{
+    if (uLength < TELEMETRY_HEADER_SIZE) {
+        return false;
+    }
+    unsigned uSeats = pui8Record[9];
+    if (uLength != TELEMETRY_HEADER_SIZE + (size_t)TELEMETRY_SEAT_SIZE * uSeats) {
+        return false;
+    }
+
+    sRecord.bKeyframe = true;
+    sRecord.uSequence = get16(pui8Record + 2);
+    sRecord.ui32TimestampMs = get32(pui8Record + 4);
+    sRecord.uCpuLoad = pui8Record[8];
+    sRecord.uGrantedMa = get16(pui8Record + 10);
+    sRecord.uRequestedMa = get16(pui8Record + 12);
+    sRecord.xSeats.resize(uSeats);
+    for (unsigned uSeat = 0; uSeat < uSeats; uSeat++) {
+        const uint8_t *pui8Seat = pui8Record + TELEMETRY_HEADER_SIZE + TELEMETRY_SEAT_SIZE * uSeat;
+        sRecord.xSeats[uSeat] = { pui8Seat[0], pui8Seat[1], pui8Seat[2], get16(pui8Seat + 3), get16(pui8Seat + 5) };
+    }
+    return true;
+}
+
+/* Reads the fields of a delta mask, false when they run past the end of the record */
+class FieldReader {
+public:
+    FieldReader(const uint8_t *pui8In, const uint8_t *pui8End) : m_pui8In(pui8In), m_pui8End(pui8End) {}
+
+    bool mask(unsigned &uMask) { return read(1, uMask); }
+
+    bool field(unsigned uMask, unsigned uBit, size_t uSize, unsigned &uValue)
+    {
+        return ((uMask & (1U << uBit)) == 0) || read(uSize, uValue);
+    }
+
+    bool atEnd() const { return m_pui8In == m_pui8End; }
+
+private:
+    bool read(size_t uSize, unsigned &uValue)
+    {
+        if ((size_t)(m_pui8End - m_pui8In) < uSize) {
+            return false;
+        }
+        uValue = (uSize == 1) ? m_pui8In[0] : get16(m_pui8In);
+        m_pui8In += uSize;
+        return true;
+    }
+
+    const uint8_t *m_pui8In;
+    const uint8_t *m_pui8End;
+};
+
+/* Delta without its CRC applied on top of sRecord, false if the layout does not match. The
+ * record is only modified when the whole delta is valid */
+bool parseDelta(const uint8_t *pui8Record, size_t uLength, StateRecord &sRecord)
+{
+    if (uLength < TELEMETRY_DELTA_HEADER_SIZE) {
+        return false;
+    }
+    StateRecord sNext = sRecord;
+    FieldReader xIn(pui8Record + TELEMETRY_DELTA_HEADER_SIZE, pui8Record + uLength);
+    unsigned uStatusMask = pui8Record[8];
+    unsigned uSeatMask = pui8Record[9];
+
+    sNext.bKeyframe = false;
+    sNext.uSequence = get16(pui8Record + 2);
+    sNext.ui32TimestampMs = get32(pui8Record + 4);
+    if (!xIn.field(uStatusMask, 0, 1, sNext.uCpuLoad) || !xIn.field(uStatusMask, 1, 2, sNext.uGrantedMa) ||
+        !xIn.field(uStatusMask, 2, 2, sNext.uRequestedMa)) {
+        return false;
+    }
+    for (size_t uSeat = 0; uSeat < 8; uSeat++) {
+        unsigned uMask;
+        if ((uSeatMask & (1U << uSeat)) == 0) {
+            continue;
+        }
+        if ((uSeat >= sNext.xSeats.size()) || !xIn.mask(uMask)) {
+            return false;
+        }
+        SeatRecord &sSeat = sNext.xSeats[uSeat];
+        if (!xIn.field(uMask, 0, 1, sSeat.uTempC) || !xIn.field(uMask, 1, 1, sSeat.uLevel) ||
+            !xIn.field(uMask, 2, 1, sSeat.uHeater) || !xIn.field(uMask, 3, 2, sSeat.uRequestedQ15) ||
+            !xIn.field(uMask, 4, 2, sSeat.uDutyQ15)) {
+            return false;
+        }
+    }
+    if (!xIn.atEnd()) {
+        return false;
+    }
+    sRecord = sNext;
+    return true;
+}
+
+void printCsvHeader(size_t uSeats)
+{
+    std::printf("record,sequence,time_ms,cpu_load_pct,granted_ma,requested_ma");
+    for (size_t uSeat = 1; uSeat <= uSeats; uSeat++) {
+        std::printf(",seat%zu_temp_c,seat%zu_level,seat%zu_heater,seat%zu_requested_pct,seat%zu_duty_pct",
+                    uSeat, uSeat, uSeat, uSeat, uSeat);
+    }
+    std::printf("\n");
+}
+
+void printCsv(const StateRecord &sRecord)
+{
+    std::printf("%s,%u,%lu,%u,%u,%u", sRecord.bKeyframe ? "key" : "delta", sRecord.uSequence, (unsigned long)sRecord.ui32TimestampMs, sRecord.uCpuLoad,
+                sRecord.uGrantedMa, sRecord.uRequestedMa);
+    for (const SeatRecord &sSeat : sRecord.xSeats) {
+        std::printf(",%u,%s,%s,%.1f,%.1f", sSeat.uTempC, levelName(sSeat.uLevel), levelName(sSeat.uHeater),
+                    dutyPercent(sSeat.uRequestedQ15), dutyPercent(sSeat.uDutyQ15));
+    }
+    std::printf("\n");
+}
+
+void printJson(const StateRecord &sRecord)
+{
+    std::printf("{\"record\":\"%s\",\"sequence\":%u,\"time_ms\":%lu,\"cpu_load_pct\":%u,\"granted_ma\":%u,"
+                "\"requested_ma\":%u,\"seats\":[",
+                sRecord.bKeyframe ? "key" : "delta", sRecord.uSequence, (unsigned long)sRecord.ui32TimestampMs, sRecord.uCpuLoad, sRecord.uGrantedMa,
+                sRecord.uRequestedMa);
+    for (size_t uSeat = 0; uSeat < sRecord.xSeats.size(); uSeat++) {
+        const SeatRecord &sSeat = sRecord.xSeats[uSeat];
+        std::printf("%s{\"temp_c\":%u,\"level\":\"%s\",\"heater\":\"%s\",\"requested_pct\":%.1f,\"duty_pct\":%.1f}",
+                    (uSeat == 0) ? "" : ",", sSeat.uTempC, levelName(sSeat.uLevel), levelName(sSeat.uHeater),
+                    dutyPercent(sSeat.uRequestedQ15), dutyPercent(sSeat.uDutyQ15));
+    }
+    std::printf("]}\n");
+}
+
+class Decoder {
+public:
+    explicit Decoder(bool bJson) : m_bJson(bJson) {}
+
+    void feed(uint8_t ui8Byte)
+    {
+        if (ui8Byte != COBS_DELIMITER) {
+            m_xFrame.push_back(ui8Byte);
+            return;
+        }
+        if (!m_xFrame.empty()) {
+            frame();
+            m_xFrame.clear();
+        }
+    }
+
+    const Counters &counters() const { return m_sCounters; }
+
+private:
+    void frame()
+    {
+        std::vector<uint8_t> xRecord(m_xFrame.size());
+        uint32 ui32Length = COBS_decode(m_xFrame.data(), (uint32)m_xFrame.size(), xRecord.data());
+
+        if (ui32Length <= TELEMETRY_CRC_SIZE) {
+            m_sCounters.ulNotCobs++;
+            return;
+        }
+        ui32Length -= TELEMETRY_CRC_SIZE;
+        if (CRC16_update(CRC16_INIT, xRecord.data(), ui32Length) != get16(&xRecord[ui32Length])) {
+            m_sCounters.ulBadCrc++;
+            return;
+        }
+        if ((ui32Length < 2) || (xRecord[0] != TELEMETRY_VERSION)) {
+            m_sCounters.ulBadLayout++;
+            return;
+        }
+        if (xRecord[1] == TELEMETRY_RECORD_LOG) {
+            /* Own sequence numbers, read by Tools/log_decode */
+            m_sCounters.ulLogFrames++;
+            return;
+        }
+
+        unsigned uSequence = get16(&xRecord[2]);
+        bool bInOrder = m_bSeen && (uSequence == ((m_uLastSequence + 1) & 0xFFFF));
+        if (m_bSeen && !bInOrder) {
+            m_sCounters.ulSequenceGaps++;
+        }
+        m_bSeen = true;
+        m_uLastSequence = uSequence;
+
+        switch (xRecord[1]) {
+        case TELEMETRY_RECORD_STATE:
+            if (!parseState(xRecord.data(), ui32Length, m_sState)) {
+                m_sCounters.ulBadLayout++;
+                return;
+            }
+            m_bSynced = true;
+            m_sCounters.ulKeyframes++;
+            break;
+        case TELEMETRY_RECORD_DELTA:
+            if (!m_bSynced || !bInOrder) {
+                /* No base until the next keyframe */
+                m_bSynced = false;
+                m_sCounters.ulUnsynced++;
+                return;
+            }
+            if (!parseDelta(xRecord.data(), ui32Length, m_sState)) {
+                m_sCounters.ulBadLayout++;
+                m_bSynced = false;
+                return;
+            }
+            break;
+        default:
+            m_sCounters.ulBadLayout++;
+            return;
+        }
+
+        if (m_bJson) {
+            printJson(m_sState);
+        } else {
+            if (!m_bHeaderPrinted) {
+                printCsvHeader(m_sState.xSeats.size());
+                m_bHeaderPrinted = true;
+            }
+            printCsv(m_sState);
+        }
+        m_sCounters.ulRecords++;
+    }
+
+    bool m_bJson;
+    std::vector<uint8_t> m_xFrame;
+    StateRecord m_sState;               /* keyframe with every delta since applied */
+    bool m_bSynced = false;
+    bool m_bSeen = false;
+    bool m_bHeaderPrinted = false;
+    unsigned m_uLastSequence = 0;
+    Counters m_sCounters;
+};
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    bool bJson = false;
+    const char *pcPath = nullptr;
+
+    for (int iArg = 1; iArg < argc; iArg++) {
+        if (std::strcmp(argv[iArg], "--json") == 0) {
+            bJson = true;
+        } else {
+            pcPath = argv[iArg];
+        }
+    }
+
+    FILE *pxIn = pcPath ? std::fopen(pcPath, "rb") : stdin;
+    if (pxIn == nullptr) {
+        std::perror(pcPath);
+        return 1;
+    }
+
+    Decoder xDecoder(bJson);
+    uint8_t pui8Buffer[4096];
+    size_t uRead;
+    while ((uRead = std::fread(pui8Buffer, 1, sizeof(pui8Buffer), pxIn)) > 0) {
+        for (size_t uIndex = 0; uIndex < uRead; uIndex++) {
+            xDecoder.feed(pui8Buffer[uIndex]);
+        }
+    }
+    if (pxIn != stdin) {
+        std::fclose(pxIn);
+    }
+
+    const Counters &sCounters = xDecoder.counters();
+    std::fprintf(stderr,
+                 "%lu records (%lu keyframes), %lu sequence gaps, skipped: %lu not COBS, %lu bad CRC, "
+                 "%lu unknown layout, %lu deltas without keyframe, %lu log frames\n",
+                 sCounters.ulRecords, sCounters.ulKeyframes, sCounters.ulSequenceGaps, sCounters.ulNotCobs,
+                 sCounters.ulBadCrc, sCounters.ulBadLayout, sCounters.ulUnsynced, sCounters.ulLogFrames);
+    return 0;
+}